@@ -0,0 +1,201 @@
+#ifndef ANYTIME_SEARCH_H
+#define ANYTIME_SEARCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "best_first_search.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+#include "search_strategy.h"
+
+// Anytime Repairing A* (Likhachev, Gordon and Thrun): weighted A* with a
+// falling weight that reuses its search effort between weights. Keys are
+// SCALE * g + scaledWeight * h as in DynamicWeightStrategy. A board whose g
+// drops after it was expanded at the current weight is parked in the
+// inconsistent list instead of being reopened, and rejoins the open list
+// when the weight drops.
+//
+// Storage is the SearchWorkspace of runBestFirstSearch. Its seen-set maps a
+// board to the arena index of the cheapest node found for it; a cheaper path
+// adds a new node, so queue entries for older nodes are stale and skipped.
+template <int N>
+struct AnytimeWorkspace {
+    SearchWorkspace<N> search;
+    std::vector<uint32_t> closedIn;      // Per node: weight round that expanded it, 0 if none
+    std::vector<uint32_t> inconsistent;  // Improved after expansion in this round
+
+    void clear() {
+        search.clear();
+        closedIn.clear();
+        inconsistent.clear();
+    }
+
+    size_t bytesUsed() const {
+        return search.bytesUsed() + closedIn.size() * sizeof(uint32_t) + inconsistent.size() * sizeof(uint32_t);
+    }
+};
+
+struct AnytimeOptions {
+    double initialWeight;
+    double weightStep;     // Weight decrease after each solution
+    double budgetSeconds;  // Search stops improving after this; the first solution is always found
+
+    AnytimeOptions() : initialWeight(3), weightStep(0.5), budgetSeconds(1) {}
+};
+
+// Runs ARA* and calls onSolution(const SearchResult&) for each improved
+// solution, with suboptimalityBound set to the proven ratio to the optimum:
+// the smaller of the weight and g(goal) over the lowest g + h still queued.
+// Returns the last solution; its bound is 1 once the search proves it optimal.
+// The workspace's node budget ends the search like the time budget does,
+// except that it also applies before the first solution.
+template <int N, typename Heuristic, typename OnSolution>
+SearchResult runAnytimeAStar(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                             const AnytimeOptions& options, AnytimeWorkspace<N>& workspace,
+                             OnSolution onSolution) {
+    const int SCALE = DynamicWeightStrategy::SCALE;
+    auto startTime = std::chrono::steady_clock::now();
+    NodeArena<SearchNode<N>>& nodes = workspace.search.nodes;
+    BucketQueue& open = workspace.search.open;
+    BoardTable<N>& seen = workspace.search.seen;
+    std::vector<uint32_t>& closedIn = workspace.closedIn;
+    std::vector<uint32_t>& inconsistent = workspace.inconsistent;
+    workspace.clear();
+
+    DynamicWeightStrategy strategy(options.initialWeight);
+    const int scaledStep = std::max(1, int(options.weightStep * SCALE + 0.5));
+    auto elapsed = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count(); };
+    auto live = [&](uint32_t index) { return *seen.find(nodes[index].board.tiles) == index; };
+
+    SearchResult result;
+    result.suboptimalityBound = strategy.bound();
+    SearchStats& stats = result.stats;
+    SearchNode<N> root = {start, NO_PARENT, 0, uint16_t(heuristic.evaluate(start))};
+    uint32_t rootIndex = nodes.add(root);
+    closedIn.push_back(0);
+    open.push(strategy.priority(root.g, root.h), rootIndex);
+    seen.insert(start.tiles, rootIndex);
+    ++stats.nodesGenerated;
+
+    const uint32_t NO_GOAL = UINT32_MAX;
+    uint32_t goalIndex = start == goal ? rootIndex : NO_GOAL;
+    int solvedCost = -1;
+    bool cutShort = false;  // Out of time or nodes
+    for (uint32_t round = 1;; ++round) {
+        // improvePath: expand until no queued key beats the goal's
+        while (!open.empty()) {
+            if (goalIndex != NO_GOAL && open.topKey() >= SCALE * nodes[goalIndex].g) {
+                break;
+            }
+            if (result.solved && stats.nodesExpanded % 1024 == 0 && elapsed() > options.budgetSeconds) {
+                cutShort = true;
+                break;
+            }
+            if (workspace.search.nodeBudget != 0 && nodes.size() + 4 > workspace.search.nodeBudget) {
+                result.budgetExhausted = true;
+                cutShort = true;
+                break;
+            }
+            uint32_t index = open.pop();
+            if (!live(index) || closedIn[index] == round) {
+                continue;
+            }
+            closedIn[index] = round;
+            const SearchNode<N> node = nodes[index];
+            ++stats.nodesExpanded;
+
+            int previousBlank = node.parent == NO_PARENT ? -1 : nodes[node.parent].board.blankIndex;
+            SuccessorBuffer<N> successors;
+            generateSuccessors(node.board, previousBlank, successors);
+            for (int i = 0; i < successors.count; ++i) {
+                const PuzzleBoard<N>& child = successors.boards[i];
+                uint16_t g = uint16_t(node.g + 1);
+                bool inserted;
+                uint32_t* best = seen.findOrInsert(child.tiles, uint32_t(nodes.size()), inserted);
+                if (!inserted) {
+                    if (g >= nodes[*best].g) {
+                        stats.countDuplicate();
+                        continue;
+                    }
+                    stats.countReopening();
+                }
+                bool wasClosed = !inserted && closedIn[*best] == round;
+                int h = inserted ? heuristic.afterMove(node.board, node.h, successors.cells[i]) : nodes[*best].h;
+                *best = nodes.add(SearchNode<N>{child, index, g, uint16_t(h)});
+                closedIn.push_back(0);
+                if (child == goal) {
+                    goalIndex = *best;
+                }
+                if (wasClosed) {
+                    inconsistent.push_back(*best);
+                } else {
+                    open.push(strategy.priority(g, h), *best);
+                }
+                ++stats.nodesGenerated;
+            }
+            stats.notePeaks(open.size() + inconsistent.size(), seen.size());
+        }
+
+        // Gather what is still queued for the bound and the next round
+        std::vector<uint32_t> pending;
+        while (!open.empty()) {
+            uint32_t index = open.pop();
+            if (live(index) && closedIn[index] != round) {
+                pending.push_back(index);
+            }
+        }
+        for (uint32_t index : inconsistent) {
+            if (live(index)) {
+                pending.push_back(index);
+            }
+        }
+        inconsistent.clear();
+
+        // Report a cheaper solution, or the same one with a tighter bound
+        if (goalIndex != NO_GOAL) {
+            int cost = nodes[goalIndex].g;
+            int lowestF = cost;
+            for (uint32_t index : pending) {
+                lowestF = std::min(lowestF, nodes[index].g + nodes[index].h);
+            }
+            // A round cut short only keeps the previous round's weight bound, if any
+            double weightBound = !cutShort       ? strategy.bound()
+                                 : solvedCost >= 0 ? result.suboptimalityBound
+                                                   : std::numeric_limits<double>::infinity();
+            double bound = lowestF > 0 ? std::min(weightBound, double(cost) / lowestF) : 1.0;
+            if (cost != solvedCost || bound < result.suboptimalityBound) {
+                solvedCost = cost;
+                result.solved = true;
+                result.moves = reconstructMoves(nodes, goalIndex);
+                result.suboptimalityBound = bound;
+                stats.seconds = elapsed();
+                onSolution(static_cast<const SearchResult&>(result));
+            }
+        }
+        if (goalIndex == NO_GOAL || cutShort || strategy.scaledWeight == SCALE || result.suboptimalityBound <= 1) {
+            break;
+        }
+
+        strategy.scaledWeight = std::max(SCALE, strategy.scaledWeight - scaledStep);
+        for (uint32_t index : pending) {
+            open.push(strategy.priority(nodes[index].g, nodes[index].h), index);
+        }
+    }
+
+    stats.seconds = elapsed();
+    stats.peakBytes = workspace.bytesUsed();
+    return result;
+}
+
+template <int N, typename Heuristic, typename OnSolution>
+SearchResult runAnytimeAStar(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                             const AnytimeOptions& options, OnSolution onSolution) {
+    AnytimeWorkspace<N> workspace;
+    return runAnytimeAStar(start, goal, heuristic, options, workspace, onSolution);
+}
+
+#endif
@@ -1,154 +1,103 @@
+#include <cstring>
 #include <iostream>
 #include <vector>
-#include <queue>
-#include <unordered_set>
 
-using namespace std;
-
-struct PuzzlePiece {
-    vector<vector<int>> configuration;
-    int totalCost;
-    int heuristicValue;
-    int movesTaken;
-    const PuzzlePiece* previousPiece;
-
-    PuzzlePiece(const vector<vector<int>>& arrangement, int cost, int heuristic, int moves, const PuzzlePiece* previous)
-        : configuration(arrangement), totalCost(cost), heuristicValue(heuristic), movesTaken(moves), previousPiece(previous) {}
+#include "best_first_search.h"
+#include "heuristics.h"
+#include "ida_star.h"
+#include "pattern_database.h"
+#include "puzzle_board.h"
+#include "puzzle_io.h"
+#include "solution_writer.h"
 
-    bool operator==(const PuzzlePiece& other) const {
-        return configuration == other.configuration;
-    }
-};
-
-struct PuzzlePieceHash {
-    size_t operator()(const PuzzlePiece& piece) const {
-        size_t hash = 0;
-        for (const auto& row : piece.configuration) {
-            for (int num : row) {
-                hash ^= hash << 6 ^ hash >> 2 ^ size_t(num) + 0x9e3779b9 + (hash << 14) + (hash >> 7);
-            }
-        }
-        return hash;
-    }
-};
+using namespace std;
 
-struct PuzzlePieceComparator {
-    bool operator()(const PuzzlePiece& a, const PuzzlePiece& b) const {
-        return a.totalCost + a.heuristicValue > b.totalCost + b.heuristicValue;
-    }
-};
+template <int N>
+void displayPuzzle(const PuzzleBoard<N>& arrangement) {
+    printBoard(cout, arrangement);
+    cout << '\n';
+}
 
-void displayPuzzle(const vector<vector<int>>& arrangement) {
-    for (const auto& row : arrangement) {
-        for (int num : row) {
-            cout << num << " ";
-        }
-        cout << endl;
+void reportThroughput(uint64_t nodesExpanded, double seconds) {
+    cout << "Nodes expanded: " << nodesExpanded;
+    if (seconds > 0) {
+        cout << " (" << uint64_t(nodesExpanded / seconds) << " nodes/sec)";
     }
     cout << endl;
 }
 
-pair<int, int> findNumberPosition(const vector<vector<int>>& arrangement, int number) {
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (arrangement[i][j] == number) {
-                return {i, j};
-            }
-        }
+// Print the solution as a move string and as boards from the start to the goal
+template <int N>
+void reportSolution(const PuzzleBoard<N>& initialConfiguration, const SearchResult& result) {
+    if (!result.solved) {
+        cout << "Goal state not reachable." << endl;
+        return;
     }
-    return {-1, -1};
-}
 
-int calculateManhattan(const PuzzlePiece& piece) {
-    int distance = 0;
-    for (int num = 1; num <= 8; ++num) {
-        pair<int, int> currentPos = findNumberPosition(piece.configuration, num);
-        pair<int, int> goalPos = {(num - 1) / 3, (num - 1) % 3};
-        distance += abs(currentPos.first - goalPos.first) + abs(currentPos.second - goalPos.second);
-    }
-    return distance;
-}
+    cout << "Goal state reached in " << result.moves.size() << " moves." << endl;
+    reportThroughput(result.stats.nodesExpanded, result.stats.seconds);
 
-bool isPositionValid(int i, int j) {
-    return i >= 0 && i < 3 && j >= 0 && j < 3;
+    BufferedWriter output(stdout);
+    output.text() += "Moves: ";
+    appendSolution(output.text(), initialConfiguration, result.moves, SolutionFormat::MOVES);
+    output.text() += "\nSolution:\n";
+    appendSolution(output.text(), initialConfiguration, result.moves, SolutionFormat::BOARDS);
 }
 
-vector<PuzzlePiece> generatePuzzlePieces(const PuzzlePiece& piece);
-
-void runAStar(const vector<vector<int>>& initialConfiguration);
-
-int main() {
-    vector<vector<int>> startConfiguration = {{1, 2, 3}, {0, 4, 6}, {7, 5, 8}};
-
-    cout << "Initial state:" << endl;
-    displayPuzzle(startConfiguration);
-
-    runAStar(startConfiguration);
-
-    return 0;
+template <int N, typename Heuristic>
+void runAStar(const PuzzleBoard<N>& initialConfiguration, const Heuristic& heuristic) {
+    reportSolution(initialConfiguration, runBestFirstSearch<AStarStrategy>(initialConfiguration, blankLastGoal<N>(), heuristic));
 }
 
-vector<PuzzlePiece> generatePuzzlePieces(const PuzzlePiece& piece) {
-    vector<PuzzlePiece> pieces;
-    pair<int, int> emptyPosition = findNumberPosition(piece.configuration, 0);
-
-    const int moves[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-
-    for (const auto& move : moves) {
-        int newI = emptyPosition.first + move[0];
-        int newJ = emptyPosition.second + move[1];
-
-        if (isPositionValid(newI, newJ)) {
-            vector<vector<int>> newConfiguration = piece.configuration;
-            swap(newConfiguration[emptyPosition.first][emptyPosition.second], newConfiguration[newI][newJ]);
-
-            int newCost = piece.totalCost + 1;
-            int newHeuristic = calculateManhattan({newConfiguration, 0, 0, 0, nullptr});
-            int newMoves = piece.movesTaken + 1;
+// Same inputs and heuristic as runAStar, in memory proportional to the depth
+template <int N, typename Heuristic>
+void runIterativeDeepening(const PuzzleBoard<N>& initialConfiguration, const Heuristic& heuristic) {
+    reportSolution(initialConfiguration, runIDAStar(initialConfiguration, blankLastGoal<N>(), heuristic));
+}
 
-            pieces.emplace_back(newConfiguration, newCost, newHeuristic, newMoves, &piece);
+// Pass --ida to solve with IDA* instead of A*, and --pdb <file> to use an
+// additive pattern database built by pdb_builder instead of Manhattan distance
+int main(int argc, char* argv[]) {
+    const int startCells[9] = {1, 2, 3, 0, 4, 6, 7, 5, 8};
+    PuzzleBoard<3> startConfiguration = PuzzleBoard<3>::fromCells(startCells);
+
+    bool iterativeDeepening = false;
+    const char* databasePath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--ida") == 0) {
+            iterativeDeepening = true;
+        } else if (strcmp(argv[i], "--pdb") == 0 && i + 1 < argc) {
+            databasePath = argv[++i];
         }
     }
 
-    return pieces;
-}
-
-void runAStar(const vector<vector<int>>& initialConfiguration) {
-    PuzzlePiece initialState{initialConfiguration, 0, calculateManhattan({initialConfiguration, 0, 0, 0, nullptr}), 0, nullptr};
-
-    priority_queue<PuzzlePiece, vector<PuzzlePiece>, PuzzlePieceComparator> openPieces;
-
-    unordered_set<PuzzlePiece, PuzzlePieceHash> closedPieces;
-
-    openPieces.push(initialState);
-
-    while (!openPieces.empty()) {
-        PuzzlePiece currentPiece = openPieces.top();
-        openPieces.pop();
-
-        if (currentPiece.heuristicValue == 0) {
-            cout << "Goal state reached in " << currentPiece.movesTaken << " moves." << endl;
-            cout << "Solution:" << endl;
-
-            while (currentPiece.previousPiece != nullptr) {
-                displayPuzzle(currentPiece.configuration);
-                currentPiece = *currentPiece.previousPiece;
-            }
-            displayPuzzle(initialState.configuration);
-            return;
-        }
+    PatternDatabase<3> database;
+    if (databasePath != nullptr && !database.load(databasePath)) {
+        cout << "Could not load a 3x3 pattern database from " << databasePath << endl;
+        return 1;
+    }
 
-        closedPieces.insert(currentPiece);
+    cout << "Initial state:" << endl;
+    displayPuzzle(startConfiguration);
 
-        vector<PuzzlePiece> successors = generatePuzzlePieces(currentPiece);
+    // IDA* never terminates on the wrong parity, so reject those boards first
+    if (!isSolvable(startConfiguration, blankLastGoal<3>())) {
+        cout << "Goal state not reachable from this puzzle." << endl;
+        return 0;
+    }
 
-        for (const PuzzlePiece& successor : successors) {
-            if (closedPieces.find(successor) == closedPieces.end()) {
-                openPieces.push(successor);
-            }
+    ManhattanHeuristic<3> manhattan(BLANK_LAST_TABLES<3>);
+    if (database.loaded()) {
+        if (iterativeDeepening) {
+            runIterativeDeepening(startConfiguration, database);
+        } else {
+            runAStar(startConfiguration, database);
         }
+    } else if (iterativeDeepening) {
+        runIterativeDeepening(startConfiguration, manhattan);
+    } else {
+        runAStar(startConfiguration, manhattan);
     }
 
-    cout << "Goal state not reachable." << endl;
+    return 0;
 }
-
@@ -0,0 +1,269 @@
+#ifndef BEST_FIRST_SEARCH_H
+#define BEST_FIRST_SEARCH_H
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "bucket_queue.h"
+#include "closed_table.h"
+#include "node_arena.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+#include "search_strategy.h"
+
+// Compact search node: the board plus 16-bit g and h
+template <int N>
+struct SearchNode {
+    PuzzleBoard<N> board;
+    uint32_t parent;  // Arena index of the parent, NO_PARENT for the start
+    uint16_t g;
+    uint16_t h;
+};
+
+// Node arena, open list and seen-set of one board width. Owned by the
+// caller so a worker can reuse the storage across solves: clear() empties
+// all three in O(1) plus one pass over the open list's buckets, keeping
+// their capacity, so a warmed-up workspace solves without allocating and
+// workers each holding one never share state. A nonzero
+// nodeBudget caps the nodes one solve may store; a search that reaches it
+// gives up with SearchResult::budgetExhausted set.
+template <int N>
+struct SearchWorkspace {
+    NodeArena<SearchNode<N>> nodes;
+    BucketQueue open;
+    BoardTable<N> seen;
+    size_t nodeBudget = 0;
+
+    // Set the node budget (0 for none). The arena and seen-set of a fresh
+    // workspace reserve room for 65536 nodes up front; a smaller budget
+    // shrinks them so the reservation stays within it too.
+    void setNodeBudget(size_t budget) {
+        nodeBudget = budget;
+        if (budget != 0 && budget < nodes.nodes.capacity()) {
+            nodes = NodeArena<SearchNode<N>>(budget);
+            seen = BoardTable<N>(budget);
+        }
+    }
+
+    void clear() {
+        nodes.clear();
+        open.clear();
+        seen.clear();
+    }
+
+    // Bytes holding the last solve's nodes, seen-set and open list. Nothing
+    // is freed during a solve, so this is also its peak.
+    size_t bytesUsed() const {
+        return nodes.size() * sizeof(SearchNode<N>) + seen.slots.size() * sizeof(typename BoardTable<N>::Slot) +
+               open.size() * sizeof(uint32_t);
+    }
+};
+
+// Bytes one node may cost a SearchWorkspace. Besides the node and its
+// open-list handle, each node may cost up to four seen-set slots, since the
+// slot array doubles once it is half full.
+template <int N>
+constexpr size_t budgetedNodeBytes() {
+    return sizeof(SearchNode<N>) + sizeof(uint32_t) + 4 * sizeof(typename BoardTable<N>::Slot);
+}
+
+// Node budget keeping a SearchWorkspace within `bytes`. A cap smaller than
+// one node still gets a budget of 1, since a budget of 0 means no cap.
+template <int N>
+constexpr size_t nodeBudgetForBytes(size_t bytes) {
+    return bytes == 0 ? 0 : std::max<size_t>(1, bytes / budgetedNodeBytes<N>());
+}
+
+// Default observer of runBestFirstSearch: tracing compiles away. A tracing
+// observer gets expanded() for every node the search expands.
+struct NoTrace {
+    template <int N>
+    void expanded(const PuzzleBoard<N>&, int, int) {}
+};
+
+// Default completion of runBestFirstSearch: no board has a known path to
+// the goal. A completion's complete() is asked for expanded boards and may
+// return true with `tail`, an optimal move sequence from that board to the
+// goal (e.g. from a solution cache) shorter than `maxLength`. stitched() is
+// called once when a search ends through such a tail.
+struct NoCompletion {
+    template <int N>
+    bool complete(const PuzzleBoard<N>&, int, std::vector<int>&) { return false; }
+    void stitched() {}
+};
+
+// Moves from the start to `index`, read off the blank cells along the path
+template <int N>
+std::vector<int> reconstructMoves(const NodeArena<SearchNode<N>>& nodes, uint32_t index) {
+    std::vector<int> moves;
+    for (uint32_t i = index; nodes[i].parent != NO_PARENT; i = nodes[i].parent) {
+        moves.push_back(nodes[i].board.blankIndex);
+    }
+    return std::vector<int>(moves.rbegin(), moves.rend());
+}
+
+// The one best-first search behind every solver. Strategy (see
+// search_strategy.h) orders the open list and Heuristic is TableHeuristic,
+// PatternDatabase or any type with evaluate()/afterMove(); both are template
+// parameters so each combination compiles to its own inlined loop.
+// The seen-set maps each board to the best g found so far. Strategies that
+// reopen queue a child when it is new or reached more cheaply and skip stale
+// queue entries on pop; the others queue each board once.
+// Detailed statistics (search_stats.h) are gathered only when enabled at
+// compile time; the PhaseTimer scopes are empty otherwise.
+// A completed board queues a stand-in goal node whose g is the full
+// stitched cost, child of that board; when it is popped first, the search
+// ends with the path to the board plus the tail. Under A* that proves the
+// stitched path optimal, just as popping the real goal would. A stand-in
+// keyed no higher than the node just popped would come off the queue next
+// (its ties aside), so the search ends on the spot instead.
+// This form takes a strategy object, for strategies configured at run time
+// such as DynamicWeightStrategy; the ones below default-construct it.
+template <typename Strategy, int N, typename Heuristic, typename Observer = NoTrace,
+          typename Completion = NoCompletion>
+SearchResult runBestFirstSearch(const Strategy& strategy, const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal,
+                                const Heuristic& heuristic, SearchWorkspace<N>& workspace,
+                                Observer observer = Observer(), Completion completion = Completion()) {
+    auto startTime = std::chrono::steady_clock::now();
+    NodeArena<SearchNode<N>>& nodes = workspace.nodes;
+    BucketQueue& open = workspace.open;
+    BoardTable<N>& seen = workspace.seen;
+    workspace.clear();
+
+    SearchResult result;
+    result.suboptimalityBound = strategy.bound();
+    SearchStats& stats = result.stats;
+    SearchNode<N> root = {start, NO_PARENT, 0, uint16_t(heuristic.evaluate(start))};
+    open.push(strategy.priority(root.g, root.h), nodes.add(root));
+    seen.insert(start.tiles, 0);
+    ++stats.nodesGenerated;
+
+    // Cheapest stitched solution so far: its stand-in node and tail. Stand-ins
+    // are marked by an h no real node has; superseded ones are skipped.
+    const uint16_t STAND_IN_H = UINT16_MAX;
+    uint32_t stitchIndex = NO_PARENT;
+    std::vector<int> stitchTail, tail;
+
+    while (!open.empty()) {
+        uint32_t index;
+        {
+            PhaseTimer<> timer(stats.queueSeconds);
+            index = open.pop();
+        }
+        const SearchNode<N> node = nodes[index];
+
+        if (node.h == STAND_IN_H) {
+            if (index != stitchIndex) {
+                continue;
+            }
+            result.solved = true;
+            result.moves = reconstructMoves(nodes, node.parent);
+            result.moves.insert(result.moves.end(), stitchTail.begin(), stitchTail.end());
+            completion.stitched();
+            break;
+        }
+
+        if constexpr (Strategy::REOPENS) {
+            PhaseTimer<> timer(stats.hashSeconds);
+            if (node.g > *seen.find(node.board.tiles)) {
+                continue;
+            }
+        }
+        if (node.board == goal) {
+            result.solved = true;
+            result.moves = reconstructMoves(nodes, index);
+            break;
+        }
+        if (workspace.nodeBudget != 0 && nodes.size() + 4 > workspace.nodeBudget) {
+            result.budgetExhausted = true;
+            break;
+        }
+        ++stats.nodesExpanded;
+        observer.expanded(node.board, node.g, node.h);
+
+        // A tail is at least h long, so once a stand-in costs no more than
+        // g + h this board cannot improve on it and the probe is skipped
+        if (stitchIndex == NO_PARENT || node.g + node.h < nodes[stitchIndex].g) {
+            int maxLength = stitchIndex == NO_PARENT ? INT_MAX : nodes[stitchIndex].g - node.g;
+            if (completion.complete(node.board, maxLength, tail)) {
+                int cost = node.g + int(tail.size());
+                if (strategy.priority(cost, 0) <= strategy.priority(node.g, node.h)) {
+                    result.solved = true;
+                    result.moves = reconstructMoves(nodes, index);
+                    result.moves.insert(result.moves.end(), tail.begin(), tail.end());
+                    completion.stitched();
+                    break;
+                }
+                stitchIndex = nodes.add(SearchNode<N>{goal, index, uint16_t(cost), STAND_IN_H});
+                stitchTail.swap(tail);
+                open.push(strategy.priority(cost, 0), stitchIndex);
+            }
+        }
+
+        // The move back to the parent is pruned before it costs a hash probe
+        int previousBlank = node.parent == NO_PARENT ? -1 : nodes[node.parent].board.blankIndex;
+        SuccessorBuffer<N> successors;
+        generateSuccessors(node.board, previousBlank, successors);
+        for (int i = 0; i < successors.count; ++i) {
+            int cell = successors.cells[i];
+            const PuzzleBoard<N>& child = successors.boards[i];
+            uint16_t g = uint16_t(node.g + 1);
+
+            bool inserted;
+            uint32_t* bestG;
+            {
+                PhaseTimer<> timer(stats.hashSeconds);
+                bestG = seen.findOrInsert(child.tiles, g, inserted);
+            }
+            if (!inserted) {
+                if (!Strategy::REOPENS || g >= *bestG) {
+                    stats.countDuplicate();
+                    continue;
+                }
+                *bestG = g;
+                stats.countReopening();
+            }
+
+            int h;
+            {
+                PhaseTimer<> timer(stats.heuristicSeconds);
+                h = heuristic.afterMove(node.board, node.h, cell);
+            }
+            // Debug builds check every incremental update against a full evaluation
+            assert(h == heuristic.evaluate(child));
+            SearchNode<N> next = {child, index, g, uint16_t(h)};
+            uint32_t nextIndex = nodes.add(next);
+            {
+                PhaseTimer<> timer(stats.queueSeconds);
+                open.push(strategy.priority(next.g, next.h), nextIndex);
+            }
+            ++stats.nodesGenerated;
+        }
+        stats.notePeaks(open.size(), seen.size());
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.peakBytes = workspace.bytesUsed();
+    return result;
+}
+
+template <typename Strategy, int N, typename Heuristic, typename Observer = NoTrace,
+          typename Completion = NoCompletion>
+SearchResult runBestFirstSearch(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                                SearchWorkspace<N>& workspace, Observer observer = Observer(),
+                                Completion completion = Completion()) {
+    return runBestFirstSearch(Strategy(), start, goal, heuristic, workspace, observer, completion);
+}
+
+// One-off solve with a workspace that is released on return
+template <typename Strategy, int N, typename Heuristic>
+SearchResult runBestFirstSearch(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic) {
+    SearchWorkspace<N> workspace;
+    return runBestFirstSearch(Strategy(), start, goal, heuristic, workspace);
+}
+
+#endif
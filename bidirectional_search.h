@@ -0,0 +1,219 @@
+#ifndef BIDIRECTIONAL_SEARCH_H
+#define BIDIRECTIONAL_SEARCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "best_first_search.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+
+// Searches that grow one frontier from the start and one from the goal and
+// splice the two half-paths where they meet. Moves are reversible, so both
+// sides use the same successor generation. Each side keeps its nodes in the
+// arena of its own SearchWorkspace, and its seen-set maps a board to the
+// arena index of the best node for it, so a meeting is one probe into the
+// other side's seen-set.
+template <int N>
+struct BidirectionalWorkspace {
+    SearchWorkspace<N> forward;
+    SearchWorkspace<N> backward;
+
+    void clear() {
+        forward.clear();
+        backward.clear();
+    }
+
+    size_t bytesUsed() const { return forward.bytesUsed() + backward.bytesUsed(); }
+};
+
+// Moves from the start through the meeting board to the goal, given the
+// meeting board's node on each side. Stepping from a backward node to its
+// parent slides the tile at the parent's blank cell.
+template <int N>
+std::vector<int> spliceMoves(const NodeArena<SearchNode<N>>& forwardNodes, uint32_t forwardIndex,
+                             const NodeArena<SearchNode<N>>& backwardNodes, uint32_t backwardIndex) {
+    std::vector<int> moves = reconstructMoves(forwardNodes, forwardIndex);
+    for (uint32_t i = backwardIndex; backwardNodes[i].parent != NO_PARENT; i = backwardNodes[i].parent) {
+        moves.push_back(backwardNodes[backwardNodes[i].parent].board.blankIndex);
+    }
+    return moves;
+}
+
+// Bidirectional breadth-first search. Each round expands one whole layer of
+// the smaller frontier. Layers are appended to the arena in order, so the
+// frontier is just the arena range added by the previous round. The first
+// round that meets the other side yields the optimal path; that round still
+// finishes, because the shortest path uses the meeting board with the
+// shallowest node on the other side.
+template <int N>
+SearchResult runBidirectionalBFS(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal,
+                                 BidirectionalWorkspace<N>& workspace) {
+    auto startTime = std::chrono::steady_clock::now();
+    workspace.clear();
+
+    SearchResult result;
+    SearchStats& stats = result.stats;
+    SearchWorkspace<N>* sides[2] = {&workspace.forward, &workspace.backward};
+    const PuzzleBoard<N> roots[2] = {start, goal};
+    size_t layerBegin[2] = {0, 0};
+    for (int s = 0; s < 2; ++s) {
+        sides[s]->nodes.add(SearchNode<N>{roots[s], NO_PARENT, 0, 0});
+        sides[s]->seen.insert(roots[s].tiles, 0);
+        ++stats.nodesGenerated;
+    }
+
+    if (start == goal) {
+        result.solved = true;
+    }
+
+    int bestLength = INT32_MAX;
+    uint32_t meeting[2] = {0, 0};
+    while (!result.solved) {
+        size_t forwardLayer = sides[0]->nodes.size() - layerBegin[0];
+        size_t backwardLayer = sides[1]->nodes.size() - layerBegin[1];
+        if (forwardLayer == 0 || backwardLayer == 0) {
+            break;
+        }
+        int s = forwardLayer <= backwardLayer ? 0 : 1;
+        SearchWorkspace<N>& side = *sides[s];
+        const SearchWorkspace<N>& other = *sides[1 - s];
+
+        size_t layerEnd = side.nodes.size();
+        for (size_t index = layerBegin[s]; index < layerEnd; ++index) {
+            const SearchNode<N> node = side.nodes[uint32_t(index)];
+            ++stats.nodesExpanded;
+
+            int previousBlank = node.parent == NO_PARENT ? -1 : side.nodes[node.parent].board.blankIndex;
+            SuccessorBuffer<N> successors;
+            generateSuccessors(node.board, previousBlank, successors);
+            for (int i = 0; i < successors.count; ++i) {
+                const PuzzleBoard<N>& child = successors.boards[i];
+                uint32_t childIndex = uint32_t(side.nodes.size());
+                if (!side.seen.insert(child.tiles, childIndex)) {
+                    stats.countDuplicate();
+                    continue;
+                }
+                side.nodes.add(SearchNode<N>{child, uint32_t(index), uint16_t(node.g + 1), 0});
+                ++stats.nodesGenerated;
+
+                const uint32_t* otherIndex = other.seen.find(child.tiles);
+                if (otherIndex != nullptr && node.g + 1 + other.nodes[*otherIndex].g < bestLength) {
+                    bestLength = node.g + 1 + other.nodes[*otherIndex].g;
+                    meeting[s] = childIndex;
+                    meeting[1 - s] = *otherIndex;
+                }
+            }
+        }
+        layerBegin[s] = layerEnd;
+        stats.notePeaks(sides[0]->nodes.size() - layerBegin[0] + sides[1]->nodes.size() - layerBegin[1],
+                        sides[0]->seen.size() + sides[1]->seen.size());
+
+        if (bestLength != INT32_MAX) {
+            result.solved = true;
+            result.moves = spliceMoves(sides[0]->nodes, meeting[0], sides[1]->nodes, meeting[1]);
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.peakBytes = workspace.bytesUsed();
+    return result;
+}
+
+// MM, the bidirectional heuristic search that meets in the middle (Holte
+// et al., 2016). Each side orders its open list by pr = max(g + h, 2g), so
+// neither side expands a node past the midpoint of an optimal path. The
+// search expands the side with the lower minimum pr and stops once the best
+// meeting found costs no more than that minimum, which makes the spliced
+// path optimal for admissible heuristics. `forwardHeuristic` estimates the
+// distance to `goal` and `backwardHeuristic` the distance to `start`.
+template <int N, typename ForwardHeuristic, typename BackwardHeuristic>
+SearchResult runMeetInTheMiddle(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal,
+                                const ForwardHeuristic& forwardHeuristic, const BackwardHeuristic& backwardHeuristic,
+                                BidirectionalWorkspace<N>& workspace) {
+    auto startTime = std::chrono::steady_clock::now();
+    workspace.clear();
+
+    SearchResult result;
+    SearchStats& stats = result.stats;
+    SearchWorkspace<N>* sides[2] = {&workspace.forward, &workspace.backward};
+    auto priority = [](int g, int h) { return std::max(g + h, 2 * g); };
+
+    const SearchNode<N> roots[2] = {{start, NO_PARENT, 0, uint16_t(forwardHeuristic.evaluate(start))},
+                                    {goal, NO_PARENT, 0, uint16_t(backwardHeuristic.evaluate(goal))}};
+    for (int s = 0; s < 2; ++s) {
+        sides[s]->open.push(priority(roots[s].g, roots[s].h), sides[s]->nodes.add(roots[s]));
+        sides[s]->seen.insert(roots[s].board.tiles, 0);
+        ++stats.nodesGenerated;
+    }
+
+    int bestLength = start == goal ? 0 : INT32_MAX;
+    uint32_t meeting[2] = {0, 0};
+    while (!sides[0]->open.empty() && !sides[1]->open.empty()) {
+        int forwardMin = sides[0]->open.topKey();
+        int backwardMin = sides[1]->open.topKey();
+        if (bestLength <= std::min(forwardMin, backwardMin)) {
+            break;
+        }
+        int s = forwardMin <= backwardMin ? 0 : 1;
+        SearchWorkspace<N>& side = *sides[s];
+        const SearchWorkspace<N>& other = *sides[1 - s];
+
+        uint32_t index = side.open.pop();
+        const SearchNode<N> node = side.nodes[index];
+        if (*side.seen.find(node.board.tiles) != index) {
+            continue;  // Superseded by a cheaper path to the same board
+        }
+        ++stats.nodesExpanded;
+
+        int previousBlank = node.parent == NO_PARENT ? -1 : side.nodes[node.parent].board.blankIndex;
+        SuccessorBuffer<N> successors;
+        generateSuccessors(node.board, previousBlank, successors);
+        for (int i = 0; i < successors.count; ++i) {
+            int cell = successors.cells[i];
+            const PuzzleBoard<N>& child = successors.boards[i];
+            uint16_t g = uint16_t(node.g + 1);
+            uint32_t childIndex = uint32_t(side.nodes.size());
+
+            bool inserted;
+            uint32_t* known = side.seen.findOrInsert(child.tiles, childIndex, inserted);
+            if (!inserted) {
+                if (side.nodes[*known].g <= g) {
+                    stats.countDuplicate();
+                    continue;
+                }
+                *known = childIndex;
+                stats.countReopening();
+            }
+
+            int h = s == 0 ? forwardHeuristic.afterMove(node.board, node.h, cell)
+                           : backwardHeuristic.afterMove(node.board, node.h, cell);
+            side.nodes.add(SearchNode<N>{child, index, g, uint16_t(h)});
+            side.open.push(priority(g, h), childIndex);
+            ++stats.nodesGenerated;
+
+            const uint32_t* otherIndex = other.seen.find(child.tiles);
+            if (otherIndex != nullptr && g + other.nodes[*otherIndex].g < bestLength) {
+                bestLength = g + other.nodes[*otherIndex].g;
+                meeting[s] = childIndex;
+                meeting[1 - s] = *otherIndex;
+            }
+        }
+        stats.notePeaks(sides[0]->open.size() + sides[1]->open.size(), sides[0]->seen.size() + sides[1]->seen.size());
+    }
+
+    if (bestLength != INT32_MAX) {
+        result.solved = true;
+        if (bestLength > 0) {
+            result.moves = spliceMoves(sides[0]->nodes, meeting[0], sides[1]->nodes, meeting[1]);
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.peakBytes = workspace.bytesUsed();
+    return result;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open list for small non-negative integer priorities (f for A*, h for
+// greedy). Each priority owns a stack of node handles, so push and pop are
+// O(1) amortized. Ties pop LIFO: the most recently generated node, which is
+// the deepest one along the current line of search, goes first.
+struct BucketQueue {
+    std::vector<std::vector<uint32_t>> buckets;
+    size_t minKey;
+    size_t count;
+
+    explicit BucketQueue(size_t maxKey = 64) : buckets(maxKey + 1), minKey(0), count(0) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void push(int key, uint32_t handle) {
+        size_t bucket = size_t(key);
+        if (bucket >= buckets.size()) {
+            buckets.resize(bucket * 2);
+        }
+        buckets[bucket].push_back(handle);
+        if (count == 0 || bucket < minKey) {
+            minKey = bucket;
+        }
+        ++count;
+    }
+
+    // Lowest priority currently queued; the queue must not be empty
+    int topKey() {
+        while (buckets[minKey].empty()) {
+            ++minKey;
+        }
+        return int(minKey);
+    }
+
+    uint32_t pop() {
+        std::vector<uint32_t>& bucket = buckets[size_t(topKey())];
+        uint32_t handle = bucket.back();
+        bucket.pop_back();
+        --count;
+        return handle;
+    }
+
+    // Empty every bucket but keep their storage for the next solve
+    void clear() {
+        for (std::vector<uint32_t>& bucket : buckets) {
+            bucket.clear();
+        }
+        minKey = 0;
+        count = 0;
+    }
+};
+
+#endif
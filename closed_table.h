@@ -0,0 +1,125 @@
+#ifndef CLOSED_TABLE_H
+#define CLOSED_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "puzzle_board.h"
+
+// Open-addressing hash table for visited/closed boards.
+// Keys are packed board words; each key carries a 32-bit payload such as a
+// node index or g. Linear probing over a power-of-two slot array kept at
+// most half full.
+//
+// A slot is in use when its epoch matches the table's, so clear() only
+// bumps the epoch: a solve after one that grew the table to millions of
+// slots does not pay to wipe them. The epoch sits in the slot's padding,
+// so slots stay the same size.
+template <typename Key>
+struct ClosedTable {
+    struct Slot {
+        Key key;
+        uint32_t value;
+        uint32_t epoch;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t count;
+    uint32_t epoch;
+
+    explicit ClosedTable(size_t expectedEntries = 1 << 16) : mask(0), count(0), epoch(1) {
+        reserve(expectedEntries);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Drop all entries but keep the slot array. O(1) except once every
+    // 2^32 - 1 clears, when the epoch wraps and the slots are wiped.
+    void clear() {
+        if (++epoch == 0) {
+            for (Slot& slot : slots) {
+                slot.epoch = 0;
+            }
+            epoch = 1;
+        }
+        count = 0;
+    }
+
+    // Make room for `entries` keys without rehashing
+    void reserve(size_t entries) {
+        size_t capacity = 16;
+        while (capacity < entries * 2) {
+            capacity <<= 1;
+        }
+        if (capacity > slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    // Single probe sequence for lookup-or-insert. Returns the payload slot of
+    // `key` and sets `inserted` when the key was not present before.
+    uint32_t* findOrInsert(Key key, uint32_t value, bool& inserted) {
+        if ((count + 1) * 2 > slots.size()) {
+            rehash(slots.size() * 2);
+        }
+        size_t i = size_t(mixBoardKey(key)) & mask;
+        while (slots[i].epoch == epoch) {
+            if (slots[i].key == key) {
+                inserted = false;
+                return &slots[i].value;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[i] = Slot{key, value, epoch};
+        ++count;
+        inserted = true;
+        return &slots[i].value;
+    }
+
+    // Returns true when `key` was newly added
+    bool insert(Key key, uint32_t value = 0) {
+        bool inserted;
+        findOrInsert(key, value, inserted);
+        return inserted;
+    }
+
+    const uint32_t* find(Key key) const {
+        size_t i = size_t(mixBoardKey(key)) & mask;
+        while (slots[i].epoch == epoch) {
+            if (slots[i].key == key) {
+                return &slots[i].value;
+            }
+            i = (i + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    bool contains(Key key) const {
+        return find(key) != nullptr;
+    }
+
+private:
+    void rehash(size_t capacity) {
+        std::vector<Slot> old(capacity, Slot{0, 0, 0});
+        old.swap(slots);
+        mask = capacity - 1;
+        for (const Slot& slot : old) {
+            if (slot.epoch == epoch) {
+                size_t i = size_t(mixBoardKey(slot.key)) & mask;
+                while (slots[i].epoch == epoch) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = slot;
+            }
+        }
+    }
+};
+
+// Closed table keyed by the packed word of an N x N board
+template <int N>
+using BoardTable = ClosedTable<typename PuzzleBoard<N>::Word>;
+
+#endif
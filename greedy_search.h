@@ -0,0 +1,260 @@
+#ifndef GREEDY_SEARCH_H
+#define GREEDY_SEARCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "best_first_search.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+#include "search_strategy.h"
+
+// Searches for a first solution fast, with no bound on its length.
+//
+// runGreedySearch is greedy best-first search (f = h) with lazy successor
+// storage. Expanding a node scores its successors and keeps them as a
+// SuccessorRanking of moves sorted by h; only the ranking's best move is
+// queued. Popping it stores that one child as a node and re-queues the
+// ranking under its next move, so a child is stored only once the search
+// actually turns to it, and most are never stored. The order of expansions
+// is still that of greedy search.
+//
+// Both searches reject boards already seen as they generate them and test
+// for the goal as they generate it, so the last move costs no extra
+// expansion. One that outgrows the workspace's node budget returns unsolved
+// with budgetExhausted and no moves. Neither has a length bound to keep, so
+// a caller that still wants a solution should fail over to weighted IDA*
+// (failOverToIDAStar with a DynamicWeightStrategy, as puzzle_solver does)
+// rather than pay for an optimal one.
+
+// Successors of one expanded node, best first by h, not yet stored. The
+// node's board and g are copied in, so storing a child reads only this.
+template <int N>
+struct SuccessorRanking {
+    PuzzleBoard<N> board;
+    uint32_t parent;  // Arena index of the expanded node
+    uint16_t g;
+    uint8_t count;
+    uint8_t next;     // Next move to store
+    uint8_t cells[4];
+    uint16_t h[4];
+};
+
+template <int N>
+struct GreedyWorkspace {
+    SearchWorkspace<N> search;  // Open entries are SuccessorRanking indices
+    std::vector<SuccessorRanking<N>> rankings;
+
+    void clear() {
+        search.clear();
+        rankings.clear();
+    }
+
+    size_t bytesUsed() const { return search.bytesUsed() + rankings.size() * sizeof(SuccessorRanking<N>); }
+
+    // The count that search.nodeBudget caps. Every generated board takes a
+    // seen-set entry even when it is never stored as a node, so boards seen
+    // stand in for nodes, and the rankings are added in node-sized units.
+    size_t budgetedNodes() const {
+        const size_t rankingBytes = rankings.size() * sizeof(SuccessorRanking<N>);
+        return search.seen.size() + (rankingBytes + budgetedNodeBytes<N>() - 1) / budgetedNodeBytes<N>();
+    }
+};
+
+template <int N, typename Heuristic, typename Observer = NoTrace>
+SearchResult runGreedySearch(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                             GreedyWorkspace<N>& workspace, Observer observer = Observer()) {
+    auto startTime = std::chrono::steady_clock::now();
+    NodeArena<SearchNode<N>>& nodes = workspace.search.nodes;
+    BucketQueue& open = workspace.search.open;
+    BoardTable<N>& seen = workspace.search.seen;
+    std::vector<SuccessorRanking<N>>& rankings = workspace.rankings;
+    workspace.clear();
+
+    SearchResult result;
+    result.suboptimalityBound = GreedyStrategy::bound();
+    SearchStats& stats = result.stats;
+    nodes.add(SearchNode<N>{start, NO_PARENT, 0, uint16_t(heuristic.evaluate(start))});
+    seen.insert(start.tiles, 0);
+    ++stats.nodesGenerated;
+
+    // Rank the successors of `node`, stored at `index`, whose parent had its
+    // blank at `previousBlank`; true when one is the goal
+    auto expand = [&](const SearchNode<N>& node, uint32_t index, int previousBlank) {
+        ++stats.nodesExpanded;
+        observer.expanded(node.board, node.g, node.h);
+
+        SuccessorBuffer<N> successors;
+        generateSuccessors(node.board, previousBlank, successors);
+        SuccessorRanking<N> ranking = {node.board, index, node.g, 0, 0, {}, {}};
+        for (int i = 0; i < successors.count; ++i) {
+            const int cell = successors.cells[i];
+            if (successors.boards[i] == goal) {
+                result.solved = true;
+                result.moves = reconstructMoves(nodes, index);
+                result.moves.push_back(cell);
+                return true;
+            }
+            if (!seen.insert(successors.boards[i].tiles, node.g + 1)) {
+                stats.countDuplicate();
+                continue;
+            }
+            ++stats.nodesGenerated;
+            // Ties go to the later move, which is what the LIFO buckets of
+            // runBestFirstSearch pop first
+            int h = heuristic.afterMove(node.board, node.h, cell);
+            int slot = ranking.count++;
+            for (; slot > 0 && ranking.h[slot - 1] >= h; --slot) {
+                ranking.cells[slot] = ranking.cells[slot - 1];
+                ranking.h[slot] = ranking.h[slot - 1];
+            }
+            ranking.cells[slot] = uint8_t(cell);
+            ranking.h[slot] = uint16_t(h);
+        }
+        if (ranking.count != 0) {
+            open.push(ranking.h[0], uint32_t(rankings.size()));
+            rankings.push_back(ranking);
+        }
+        stats.notePeaks(open.size(), seen.size());
+        return false;
+    };
+
+    if (start == goal) {
+        result.solved = true;
+    } else {
+        bool solved = expand(nodes[0], 0, -1);
+        while (!solved && !open.empty()) {
+            if (workspace.search.nodeBudget != 0 && workspace.budgetedNodes() + 4 > workspace.search.nodeBudget) {
+                result.budgetExhausted = true;
+                break;
+            }
+            const uint32_t r = open.pop();
+            SuccessorRanking<N>& ranking = rankings[r];
+            const uint32_t parent = ranking.parent;
+            const int cell = ranking.cells[ranking.next];
+            const int h = ranking.h[ranking.next];
+            if (++ranking.next < ranking.count) {
+                open.push(ranking.h[ranking.next], r);
+            }
+
+            const SearchNode<N> child = {ranking.board.moved(cell), parent, uint16_t(ranking.g + 1), uint16_t(h)};
+            solved = expand(child, nodes.add(child), ranking.board.blankIndex);
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.peakBytes = workspace.bytesUsed();
+    return result;
+}
+
+// One-off greedy solve with a workspace that is released on return
+template <int N, typename Heuristic>
+SearchResult runGreedySearch(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic) {
+    GreedyWorkspace<N> workspace;
+    return runGreedySearch(start, goal, heuristic, workspace);
+}
+
+// Nodes one breadth-first plateau search of runEnforcedHillClimbing may
+// store before it hands over to greedy best-first search
+const size_t DEFAULT_PLATEAU_NODES = 1 << 16;
+
+// Enforced hill-climbing (Hoffmann and Nebel). From the current board, a
+// breadth-first search runs until it generates a board with a lower h, and
+// that board becomes the current one, so plateaus and local minima are
+// escaped by breadth-first search. Each phase starts over in the workspace
+// (its clears are O(1)) and appends its moves to the solution, so memory is
+// that of the widest phase. The nodes of a phase are appended to the arena
+// in breadth-first order, so the arena is its queue.
+// The climb commits to each improvement, and with Manhattan-like
+// heuristics some minima are too wide to escape cheaply: a phase that
+// outgrows `plateauNodes` hands the rest of the solve to runGreedySearch
+// from the current board.
+template <int N, typename Heuristic, typename Observer = NoTrace>
+SearchResult runEnforcedHillClimbing(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal,
+                                     const Heuristic& heuristic, GreedyWorkspace<N>& workspace,
+                                     Observer observer = Observer(), size_t plateauNodes = DEFAULT_PLATEAU_NODES) {
+    auto startTime = std::chrono::steady_clock::now();
+    NodeArena<SearchNode<N>>& nodes = workspace.search.nodes;
+    BoardTable<N>& seen = workspace.search.seen;
+    const size_t nodeBudget = workspace.search.nodeBudget;
+
+    SearchResult result;
+    result.suboptimalityBound = GreedyStrategy::bound();
+    SearchStats& stats = result.stats;
+    ++stats.nodesGenerated;
+
+    PuzzleBoard<N> current = start;
+    int currentH = heuristic.evaluate(start);
+    int previousBlank = -1;  // Blank before the last committed move
+    bool stuck = false;
+    while (!(current == goal)) {
+        workspace.clear();
+        nodes.add(SearchNode<N>{current, NO_PARENT, 0, uint16_t(currentH)});
+        seen.insert(current.tiles, 0);
+        uint32_t improved = NO_PARENT;
+        for (uint32_t next = 0; next < nodes.size() && improved == NO_PARENT; ++next) {
+            if (nodes.size() + 4 > plateauNodes || (nodeBudget != 0 && nodes.size() + 4 > nodeBudget)) {
+                break;
+            }
+            const SearchNode<N> node = nodes[next];
+            ++stats.nodesExpanded;
+            observer.expanded(node.board, node.g, node.h);
+
+            int parentBlank = node.parent == NO_PARENT ? previousBlank : nodes[node.parent].board.blankIndex;
+            SuccessorBuffer<N> successors;
+            generateSuccessors(node.board, parentBlank, successors);
+            for (int i = 0; i < successors.count; ++i) {
+                const PuzzleBoard<N>& child = successors.boards[i];
+                if (!seen.insert(child.tiles, node.g + 1)) {
+                    stats.countDuplicate();
+                    continue;
+                }
+                ++stats.nodesGenerated;
+                int h = heuristic.afterMove(node.board, node.h, successors.cells[i]);
+                uint32_t index = nodes.add(SearchNode<N>{child, next, uint16_t(node.g + 1), uint16_t(h)});
+                // The goal has the lowest h of all, so this is also the goal test
+                if (h < currentH || child == goal) {
+                    improved = index;
+                    break;
+                }
+            }
+            stats.notePeaks(nodes.size() - next, seen.size());
+        }
+        stats.peakBytes = std::max<uint64_t>(stats.peakBytes, workspace.bytesUsed());
+        if (improved == NO_PARENT) {
+            stuck = true;
+            break;
+        }
+        std::vector<int> climb = reconstructMoves(nodes, improved);
+        result.moves.insert(result.moves.end(), climb.begin(), climb.end());
+        previousBlank = nodes[nodes[improved].parent].board.blankIndex;
+        current = nodes[improved].board;
+        currentH = nodes[improved].h;
+    }
+
+    if (stuck) {
+        SearchResult rest = runGreedySearch(current, goal, heuristic, workspace, observer);
+        result.solved = rest.solved;
+        result.budgetExhausted = rest.budgetExhausted;
+        if (rest.solved) {
+            result.moves.insert(result.moves.end(), rest.moves.begin(), rest.moves.end());
+        } else {
+            result.moves.clear();  // The climb so far is no solution
+        }
+        stats.nodesExpanded += rest.stats.nodesExpanded;
+        stats.nodesGenerated += rest.stats.nodesGenerated;
+        stats.duplicatesRejected += rest.stats.duplicatesRejected;
+        stats.peakOpen = std::max(stats.peakOpen, rest.stats.peakOpen);
+        stats.peakClosed = std::max(stats.peakClosed, rest.stats.peakClosed);
+        stats.peakBytes = std::max(stats.peakBytes, rest.stats.peakBytes);
+    } else {
+        result.solved = true;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+#endif
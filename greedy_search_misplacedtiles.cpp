@@ -1,148 +1,60 @@
 #include <bits/stdc++.h>
-#include <chrono>
+
+#include "greedy_search.h"
+#include "heuristics.h"
+#include "puzzle_board.h"
+#include "solution_writer.h"
 
 using namespace std;
-using namespace chrono;
 
 #define MATRIX_SIZE 3
-int totalMoves = 0;
-int rowOffsets[] = {1, 0, -1, 0};
-int colOffsets[] = {0, -1, 0, 1};
-
-int goalMatrix[MATRIX_SIZE][MATRIX_SIZE] = {
-    {0, 1, 2},
-    {3, 4, 5},
-    {6, 7, 8}
-};
 
-struct PuzzleNode {
-    PuzzleNode *parent;
-    int matrix[MATRIX_SIZE][MATRIX_SIZE];
-    int positionRow, positionCol;
-    int cost;
-    int level;
-    int heuristic;
+const int goalCells[MATRIX_SIZE * MATRIX_SIZE] = {
+    0, 1, 2,
+    3, 4, 5,
+    6, 7, 8
 };
+const PuzzleBoard<MATRIX_SIZE> goalMatrix = PuzzleBoard<MATRIX_SIZE>::fromCells(goalCells);
 
-int displayMatrix(int matrix[MATRIX_SIZE][MATRIX_SIZE]) {
-    for (int i = 0; i < MATRIX_SIZE; i++) {
-        for (int j = 0; j < MATRIX_SIZE; j++)
-            printf("%d ", matrix[i][j]);
+template <int N>
+int displayMatrix(const PuzzleBoard<N> &layout) {
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++)
+            printf("%d ", layout.tileAt(i * N + j));
         printf("\n");
     }
     return 0;
 }
 
-PuzzleNode *generateNode(int matrix[MATRIX_SIZE][MATRIX_SIZE], int x, int y, int newX, int newY, int level, PuzzleNode *parent) {
-    PuzzleNode *node = new PuzzleNode;
-    node->parent = parent;
-
-    for (int i = 0; i < MATRIX_SIZE; i++) {
-        for (int j = 0; j < MATRIX_SIZE; j++) {
-            node->matrix[i][j] = matrix[i][j];
-        }
-    }
-
-    int temp = node->matrix[x][y];
-    node->matrix[x][y] = node->matrix[newX][newY];
-    node->matrix[newX][newY] = temp;
-    node->cost = INT_MAX;
-    node->level = level;
-    node->positionRow = newX;
-    node->positionCol = newY;
-    return node;
+// Print the blank's moves, then every board from the start to the solved one
+template <int N>
+void showPuzzle(const PuzzleBoard<N> &initial, const vector<int> &moves) {
+    BufferedWriter output(stdout);
+    output.text() += "Moves: ";
+    appendSolution(output.text(), initial, moves, SolutionFormat::MOVES);
+    output.text() += "\n";
+    appendSolution(output.text(), initial, moves, SolutionFormat::BOARDS);
 }
 
-int calculateCost(int matrix[MATRIX_SIZE][MATRIX_SIZE], int goal[MATRIX_SIZE][MATRIX_SIZE]) {
-    int count = 0;
-    for (int i = 0; i < MATRIX_SIZE; i++)
-        for (int j = 0; j < MATRIX_SIZE; j++)
-            if (matrix[i][j] != goal[i][j])
-                count++;
-    return count;
-}
-
-int calculateHeuristic(int matrix[MATRIX_SIZE][MATRIX_SIZE], int goal[MATRIX_SIZE][MATRIX_SIZE]) {
-    int heuristic = 0;
-    for (int i = 0; i < MATRIX_SIZE; i++)
-        for (int j = 0; j < MATRIX_SIZE; j++)
-            if (matrix[i][j] != goal[i][j])
-                heuristic++;
-    return heuristic;
-}
-
-int isWithinBounds(int x, int y) {
-    return (x >= 0 && x < MATRIX_SIZE && y >= 0 && y < MATRIX_SIZE);
-}
+template <int N>
+void solvePuzzle(const PuzzleBoard<N> &initial, const PuzzleBoard<N> &goal) {
+    // Misplaced-tiles count (blank excluded) against this goal
+    const HeuristicTables<N> goalTables(goal);
+    SearchResult result = runGreedySearch(initial, goal, MisplacedTilesHeuristic<N>(goalTables));
 
-void showPuzzle(PuzzleNode *root) {
-    if (root == NULL)
+    if (!result.solved) {
+        cout << "Goal state not reachable.\n";
         return;
-    showPuzzle(root->parent);
-    displayMatrix(root->matrix);
-    printf("\n");
-}
-
-struct PuzzleNodeComparator {
-    bool operator()(const PuzzleNode *lhs, const PuzzleNode *rhs) const {
-        return lhs->heuristic > rhs->heuristic;
     }
-};
 
-std::string matrixToString(int matrix[MATRIX_SIZE][MATRIX_SIZE]) {
-    std::ostringstream oss;
-    for (int i = 0; i < MATRIX_SIZE; i++) {
-        for (int j = 0; j < MATRIX_SIZE; j++) {
-            oss << matrix[i][j] << " ";
-        }
-    }
-    return oss.str();
-}
-
-void solvePuzzle(int initial[MATRIX_SIZE][MATRIX_SIZE], int x, int y, int goal[MATRIX_SIZE][MATRIX_SIZE]) {
-    auto startTime = high_resolution_clock::now();
-
-    priority_queue<PuzzleNode *, vector<PuzzleNode *>, PuzzleNodeComparator> pq;
-
-    unordered_set<string> visited;
-
-    PuzzleNode *root = generateNode(initial, x, y, x, y, 0, NULL);
-    root->cost = calculateCost(initial, goal);
-    root->heuristic = calculateHeuristic(initial, goal);
-    pq.push(root);
-
-    while (!pq.empty()) {
-        PuzzleNode *min = pq.top();
-        pq.pop();
-
-        if (min->cost == 0) {
-            auto endTime = high_resolution_clock::now();
-            auto duration = duration_cast<milliseconds>(endTime - startTime);
-
-            cout << "Goal state reached in " << totalMoves << " moves.\n";
-            cout << "Time taken: " << duration.count() << " milliseconds\n";
-            showPuzzle(min);
-            return;
-        }
-
-        for (int i = 0; i < 4; i++) {
-            if (isWithinBounds(min->positionRow + rowOffsets[i], min->positionCol + colOffsets[i])) {
-                PuzzleNode *child = generateNode(min->matrix, min->positionRow, min->positionCol, min->positionRow + rowOffsets[i], min->positionCol + colOffsets[i], min->level + 1, min);
-                child->cost = calculateCost(child->matrix, goal);
-                child->heuristic = calculateHeuristic(child->matrix, goal);
-
-                if (visited.find(matrixToString(child->matrix)) == visited.end()) {
-                    pq.push(child);
-                    visited.insert(matrixToString(child->matrix));
-                    totalMoves++;
-                }
-            }
-        }
-    }
+    cout << "Goal state reached in " << result.moves.size() << " moves.\n";
+    cout << "Nodes generated: " << result.stats.nodesGenerated << "\n";
+    cout << "Time taken: " << int64_t(result.stats.seconds * 1000) << " milliseconds\n";
+    showPuzzle(initial, result.moves);
 }
 
 int main() {
-    int initial[MATRIX_SIZE][MATRIX_SIZE];
+    int initialCells[MATRIX_SIZE * MATRIX_SIZE];
 
     cout << "\n\t\t----------------------------------------------------------------------------\n";
     cout << " Enter the initial state of the puzzle in this format \n";
@@ -150,16 +62,30 @@ int main() {
 
     for (int i = 0; i < MATRIX_SIZE; i++)
         for (int j = 0; j < MATRIX_SIZE; j++)
-            cin >> initial[i][j];
+            cin >> initialCells[i * MATRIX_SIZE + j];
+
+    if (!cin || !isTilePermutation(initialCells, MATRIX_SIZE * MATRIX_SIZE)) {
+        cout << "Invalid puzzle: enter each tile from 0 to " << MATRIX_SIZE * MATRIX_SIZE - 1 << " exactly once.\n";
+        return 1;
+    }
+
+    // The blank position comes from the input rather than being assumed
+    PuzzleBoard<MATRIX_SIZE> initial = PuzzleBoard<MATRIX_SIZE>::fromCells(initialCells);
 
     cout << "The entered initial puzzle is:  \n>> ";
     displayMatrix(initial);
     cout << "\n\t\t----------------------------------------------------------------------------\n";
-    cout << "Solving the Puzzle  \n>> ";
+    cout << "Blank tile found at row " << initial.blankRow() << ", column " << initial.blankCol() << "\n";
 
-    int startRow = 1, startCol = 2;
+    // Boards of the wrong parity would exhaust half the state space first
+    if (!isSolvable(initial, goalMatrix)) {
+        cout << "Goal state not reachable from this puzzle (inversion parity differs).\n";
+        return 0;
+    }
+
+    cout << "Solving the Puzzle  \n>> ";
 
-    solvePuzzle(initial, startRow, startCol, goalMatrix);
+    solvePuzzle(initial, goalMatrix);
 
     return 0;
 }
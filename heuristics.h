@@ -0,0 +1,251 @@
+#ifndef HEURISTICS_H
+#define HEURISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "puzzle_board.h"
+#include "simd_heuristics.h"
+
+// Number of line keys of an N-wide board: N digits in base N + 1
+constexpr int lineKeyCount(int n) {
+    int keys = 1;
+    for (int i = 0; i < n; ++i) {
+        keys *= n + 1;
+    }
+    return keys;
+}
+
+// Per-tile, per-cell heuristic contributions for one goal board.
+// manhattan[t][c] is the distance of tile t at cell c from its goal cell and
+// misplaced[t][c] is 1 when c is not t's goal cell; both are 0 for the blank.
+// lineWeight[axis][t][c] is tile t's digit in the line key of the row
+// (axis 0) or column (axis 1) through c: its goal position along the line
+// plus one if its goal is in that line, else 0, times (N + 1) to the power
+// of c's position along the line.
+// simd is the same goal laid out for the kernels of simd_heuristics.h.
+// Constructible at compile time, so fixed goals get constant tables.
+template <int N>
+struct HeuristicTables {
+    static constexpr int CELLS = N * N;
+
+    uint8_t goalCell[CELLS];
+    uint8_t manhattan[CELLS][CELLS];
+    uint8_t misplaced[CELLS][CELLS];
+    uint16_t lineWeight[2][CELLS][CELLS];
+    SimdGoal simd;
+
+    constexpr explicit HeuristicTables(const PuzzleBoard<N>& goal)
+        : goalCell(), manhattan(), misplaced(), lineWeight(), simd(makeSimdGoal<N>(goal)) {
+        for (int cell = 0; cell < CELLS; ++cell) {
+            goalCell[goal.tileAt(cell)] = uint8_t(cell);
+        }
+        for (int tile = 1; tile < CELLS; ++tile) {
+            for (int cell = 0; cell < CELLS; ++cell) {
+                int target = goalCell[tile];
+                int rowDistance = cell / N > target / N ? cell / N - target / N : target / N - cell / N;
+                int colDistance = cell % N > target % N ? cell % N - target % N : target % N - cell % N;
+                manhattan[tile][cell] = uint8_t(rowDistance + colDistance);
+                misplaced[tile][cell] = uint8_t(cell != target);
+
+                int rowPower = 1;
+                for (int i = 0; i < cell % N; ++i) {
+                    rowPower *= N + 1;
+                }
+                int colPower = 1;
+                for (int i = 0; i < cell / N; ++i) {
+                    colPower *= N + 1;
+                }
+                if (target / N == cell / N) {
+                    lineWeight[0][tile][cell] = uint16_t((target % N + 1) * rowPower);
+                }
+                if (target % N == cell % N) {
+                    lineWeight[1][tile][cell] = uint16_t((target / N + 1) * colPower);
+                }
+            }
+        }
+    }
+};
+
+// Per line key: how many of the tiles in the line whose goal is in it must
+// leave the line so the rest can reach their goals without passing each
+// other, i.e. their count minus the longest run in goal order
+template <int N>
+struct LineConflictTable {
+    static constexpr int KEYS = lineKeyCount(N);
+
+    uint8_t removed[KEYS];
+
+    constexpr LineConflictTable() : removed() {
+        for (int key = 0; key < KEYS; ++key) {
+            int goals[N] = {};
+            int count = 0;
+            for (int rest = key, i = 0; i < N; ++i, rest /= N + 1) {
+                if (rest % (N + 1) != 0) {
+                    goals[count++] = rest % (N + 1);
+                }
+            }
+            int longest[N] = {};
+            int best = 0;
+            for (int i = 0; i < count; ++i) {
+                longest[i] = 1;
+                for (int j = 0; j < i; ++j) {
+                    if (goals[j] < goals[i] && longest[j] + 1 > longest[i]) {
+                        longest[i] = longest[j] + 1;
+                    }
+                }
+                best = longest[i] > best ? longest[i] : best;
+            }
+            removed[key] = uint8_t(count - best);
+        }
+    }
+};
+
+template <int N>
+constexpr LineConflictTable<N> LINE_CONFLICTS{};
+
+// Tables for the two goal layouts, built at compile time per width
+template <int N>
+constexpr HeuristicTables<N> BLANK_LAST_TABLES{blankLastGoal<N>()};
+
+template <int N>
+constexpr HeuristicTables<N> BLANK_FIRST_TABLES{blankFirstGoal<N>()};
+
+// Full recompute of a table-driven heuristic over every cell
+template <int N>
+inline int tableHeuristic(const uint8_t table[][N * N], const PuzzleBoard<N>& board) {
+    int total = 0;
+    for (int cell = 0; cell < N * N; ++cell) {
+        total += table[board.tileAt(cell)][cell];
+    }
+    return total;
+}
+
+template <int N>
+inline int manhattanDistance(const PuzzleBoard<N>& board, const HeuristicTables<N>& tables) {
+    return tableHeuristic<N>(tables.manhattan, board);
+}
+
+template <int N>
+inline int misplacedTiles(const PuzzleBoard<N>& board, const HeuristicTables<N>& tables) {
+    return tableHeuristic<N>(tables.misplaced, board);
+}
+
+// Change of a table-driven heuristic when the tile at `cell` slides into the
+// blank of `board`. Only that tile moves, so this is two lookups.
+template <int N>
+inline int heuristicDelta(const uint8_t table[][N * N], const PuzzleBoard<N>& board, int cell) {
+    int tile = board.tileAt(cell);
+    return table[tile][board.blankIndex] - table[tile][cell];
+}
+
+// Heuristic over one HeuristicTables table (Manhattan or misplaced).
+// Search engines take any type with evaluate() for a full computation and
+// afterMove() for the value after sliding the tile at `cell` into the blank.
+template <int N>
+struct TableHeuristic {
+    const uint8_t (*table)[N * N];
+
+    int evaluate(const PuzzleBoard<N>& board) const {
+        return tableHeuristic<N>(table, board);
+    }
+
+    int afterMove(const PuzzleBoard<N>& board, int h, int cell) const {
+        return h + heuristicDelta<N>(table, board, cell);
+    }
+};
+
+// Table heuristic whose full evaluations go through a SIMD kernel at the
+// level detected at startup, for boards up to 4x4. Without SIMD support (or
+// for 5x5) the fallback is the table loop, which beats the portable kernel.
+// evaluateBatch() scores many boards in one call. The search engines do not
+// use it: their two-lookup afterMove() beats a full evaluation of each
+// successor, batched or not.
+template <int N, SimdKernel Kernel>
+struct SimdTableHeuristic : TableHeuristic<N> {
+    const SimdGoal* simd;
+
+    SimdTableHeuristic(const uint8_t (*table)[N * N], const SimdGoal& goal) : TableHeuristic<N>{table}, simd(&goal) {}
+
+    int evaluate(const PuzzleBoard<N>& board) const {
+        if constexpr (N <= 4) {
+            if (activeSimdLevel() != SimdLevel::SCALAR) {
+                return evaluateBoard<Kernel>(activeSimdLevel(), board, *simd);
+            }
+        }
+        return TableHeuristic<N>::evaluate(board);
+    }
+
+    void evaluateBatch(const PuzzleBoard<N>* boards, size_t count, int* out) const {
+        if constexpr (N <= 4) {
+            if (activeSimdLevel() != SimdLevel::SCALAR) {
+                evaluateBoards<Kernel>(activeSimdLevel(), boards, count, *simd, out);
+                return;
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = TableHeuristic<N>::evaluate(boards[i]);
+        }
+    }
+};
+
+// Named heuristic policies, one type per heuristic so the search can be
+// instantiated for each
+template <int N>
+struct ManhattanHeuristic : SimdTableHeuristic<N, SimdKernel::MANHATTAN> {
+    explicit ManhattanHeuristic(const HeuristicTables<N>& tables)
+        : SimdTableHeuristic<N, SimdKernel::MANHATTAN>(tables.manhattan, tables.simd) {}
+};
+
+template <int N>
+struct MisplacedTilesHeuristic : SimdTableHeuristic<N, SimdKernel::MISPLACED> {
+    explicit MisplacedTilesHeuristic(const HeuristicTables<N>& tables)
+        : SimdTableHeuristic<N, SimdKernel::MISPLACED>(tables.misplaced, tables.simd) {}
+};
+
+// Manhattan distance plus linear conflicts (Hansson, Mayer and Yung): each
+// tile that must leave its goal row to let another tile of that row pass
+// costs two moves beyond Manhattan, and likewise for columns. Rows and
+// columns count separately, since leaving a row takes vertical moves and
+// leaving a column horizontal ones, so the sum stays admissible.
+template <int N>
+struct LinearConflictHeuristic {
+    ManhattanHeuristic<N> manhattan;
+    const HeuristicTables<N>* tables;
+
+    explicit LinearConflictHeuristic(const HeuristicTables<N>& goalTables)
+        : manhattan(goalTables), tables(&goalTables) {}
+
+    // Tiles that must leave row (axis 0) or column (axis 1) `line`
+    int lineConflicts(const PuzzleBoard<N>& board, int axis, int line) const {
+        int key = 0;
+        for (int i = 0; i < N; ++i) {
+            int cell = axis == 0 ? line * N + i : i * N + line;
+            key += tables->lineWeight[axis][board.tileAt(cell)][cell];
+        }
+        return LINE_CONFLICTS<N>.removed[key];
+    }
+
+    int evaluate(const PuzzleBoard<N>& board) const {
+        int removed = 0;
+        for (int line = 0; line < N; ++line) {
+            removed += lineConflicts(board, 0, line) + lineConflicts(board, 1, line);
+        }
+        return manhattan.evaluate(board) + 2 * removed;
+    }
+
+    // A vertical move changes only the two rows it joins, a horizontal one
+    // the two columns; the other lines keep their tiles in the same order
+    int afterMove(const PuzzleBoard<N>& board, int h, int cell) const {
+        const int blank = board.blankIndex;
+        const int axis = cell / N == blank / N ? 1 : 0;
+        const int from = axis == 0 ? cell / N : cell % N;
+        const int to = axis == 0 ? blank / N : blank % N;
+        PuzzleBoard<N> next = board.moved(cell);
+        int change = lineConflicts(next, axis, from) + lineConflicts(next, axis, to) -
+                     lineConflicts(board, axis, from) - lineConflicts(board, axis, to);
+        return manhattan.afterMove(board, h, cell) + 2 * change;
+    }
+};
+
+#endif
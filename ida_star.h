@@ -0,0 +1,121 @@
+#ifndef IDA_STAR_H
+#define IDA_STAR_H
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "heuristics.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+#include "search_strategy.h"
+
+// Iterative deepening A* on f = g + h. Only the current path is kept: one
+// board is updated in place by make/unmake moves, so memory is proportional
+// to the solution depth. The move that would undo the previous one is pruned.
+// The goal test compares boards, so a heuristic that is 0 away from the goal
+// (a pattern database missing some tiles) cannot end the search early.
+// Heuristic is TableHeuristic, PatternDatabase or any type with the same
+// evaluate()/afterMove() interface. Strategy (search_strategy.h) turns g and
+// h into the f that is cut off at the bound; a weighted strategy makes this
+// weighted IDA*, whose solutions cost at most the weight times the optimum.
+// The priority must grow with g, so GreedyStrategy does not qualify.
+template <int N, typename Heuristic, typename Strategy = AStarStrategy>
+struct IDAStarSearch {
+    const Heuristic& heuristic;
+    Strategy strategy;
+    PuzzleBoard<N> board;
+    PuzzleBoard<N> goal;
+    std::vector<int> moves;
+    uint64_t nodesExpanded;
+    uint64_t nodesGenerated;
+    int bound;
+
+    static const int FOUND = -1;
+
+    IDAStarSearch(const PuzzleBoard<N>& start, const PuzzleBoard<N>& searchGoal, const Heuristic& searchHeuristic,
+                  const Strategy& searchStrategy = Strategy())
+        : heuristic(searchHeuristic), strategy(searchStrategy), board(start), goal(searchGoal), nodesExpanded(0), nodesGenerated(0), bound(0) {}
+
+    // Depth-first probe below the current bound. Returns FOUND or the
+    // smallest f that exceeded the bound.
+    int probe(int g, int h, int previousBlank) {
+        int f = strategy.priority(g, h);
+        if (f > bound) {
+            return f;
+        }
+        if (board == goal) {
+            return FOUND;
+        }
+        ++nodesExpanded;
+
+        int blank = board.blankIndex;
+        int nextBound = INT_MAX;
+
+        for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+            int cell = MOVE_TABLE<N>.neighbors[blank][i];
+            if (cell == previousBlank) {
+                continue;
+            }
+
+            ++nodesGenerated;
+            int childH = heuristic.afterMove(board, h, cell);
+            board = board.moved(cell);
+            moves.push_back(cell);
+
+            int t = probe(g + 1, childH, blank);
+            if (t == FOUND) {
+                return FOUND;
+            }
+
+            moves.pop_back();
+            board = board.moved(blank);
+            if (t < nextBound) {
+                nextBound = t;
+            }
+        }
+        return nextBound;
+    }
+};
+
+// Solve `start` with IDA* ordered by `strategy`, within strategy.bound()
+// times the optimum; `heuristic` must be admissible for `goal`
+template <typename Strategy, int N, typename Heuristic>
+inline SearchResult runIDAStar(const Strategy& strategy, const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal,
+                               const Heuristic& heuristic) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    IDAStarSearch<N, Heuristic, Strategy> search(start, goal, heuristic, strategy);
+    int h = heuristic.evaluate(start);
+    search.bound = strategy.priority(0, h);
+
+    SearchResult result;
+    result.suboptimalityBound = strategy.bound();
+    while (true) {
+        int t = search.probe(0, h, -1);
+        if (t == IDAStarSearch<N, Heuristic, Strategy>::FOUND) {
+            result.solved = true;
+            break;
+        }
+        if (t == INT_MAX) {
+            break;
+        }
+        search.bound = t;
+    }
+
+    result.moves = search.moves;
+    result.stats.nodesExpanded = search.nodesExpanded;
+    result.stats.nodesGenerated = search.nodesGenerated;
+    result.stats.peakBytes = sizeof(search) + search.moves.capacity() * sizeof(int);
+    result.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+// Solve `start` optimally with IDA*
+template <int N, typename Heuristic>
+inline SearchResult runIDAStar(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic) {
+    return runIDAStar(AStarStrategy(), start, goal, heuristic);
+}
+
+#endif
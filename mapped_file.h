@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only, shared memory mapping of a whole file. The pages are shared
+// between every process mapping the same file and are only read in on
+// first touch, so opening costs the same whatever the file size.
+struct MappedFile {
+    const unsigned char* data;
+    size_t size;
+
+    MappedFile() : data(nullptr), size(0) {}
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+
+    // Map `path`, which must hold at least `minimumSize` bytes
+    bool open(const char* path, size_t minimumSize) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || size_t(info.st_size) < minimumSize || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapping = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        data = static_cast<const unsigned char*>(mapping);
+        size = size_t(info.st_size);
+        return true;
+    }
+
+    void close() {
+        if (data != nullptr) {
+            munmap(const_cast<unsigned char*>(data), size);
+        }
+        data = nullptr;
+        size = 0;
+    }
+};
+
+#endif
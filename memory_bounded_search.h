@@ -0,0 +1,228 @@
+#ifndef MEMORY_BOUNDED_SEARCH_H
+#define MEMORY_BOUNDED_SEARCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "ida_star.h"
+#include "node_arena.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+
+// Simplified memory-bounded A* (SMA*, Russell 1992) over a pool of at most
+// nodeBudget nodes. The search is a tree search like IDA* (only the move
+// back to the parent is pruned), ordered by f with the path-max rule. When
+// the pool is full, the leaf with the highest f (the shallowest on ties) is
+// dropped and its f backed up into its parent's forgottenF; the parent then
+// waits in the open list under that f and regenerates the dropped children
+// when it comes up again. Every queued key stays a lower bound on the
+// solutions below it, so the first goal popped is optimal as long as the
+// solution path fits in the pool. When it does not, the search stops with
+// budgetExhausted set; see failOverToIDAStar.
+template <int N>
+struct SmaNode {
+    PuzzleBoard<N> board;
+    uint32_t parent;   // Pool index of the parent, NO_PARENT for the start
+    uint16_t g;
+    uint16_t h;
+    int key;           // Open-list key: f when generated, forgottenF once expanded
+    int forgottenF;    // Lowest key of dropped children, INT_MAX if none
+    uint8_t slot;      // Neighbour index of this node's blank in the parent's MOVE_TABLE row
+    uint8_t children;  // Bit per neighbour index: child currently stored
+    bool queued;
+};
+
+// Node pool and open list, reusable across solves. Open entries are
+// (key, -g, index), so the lowest f pops first with the deepest node on
+// ties. `leaves` indexes the queued nodes without stored children the same
+// way; its last entry is the next one to drop.
+template <int N>
+struct SmaWorkspace {
+    using OpenEntry = std::tuple<int, int, uint32_t>;
+
+    // Approximate bytes of one std::set entry: the key plus the tree links
+    static constexpr size_t OPEN_ENTRY_BYTES = sizeof(OpenEntry) + 4 * sizeof(void*);
+
+    std::vector<SmaNode<N>> nodes;
+    std::vector<uint32_t> freeList;
+    std::set<OpenEntry> open;
+    std::set<OpenEntry> leaves;
+};
+
+// Node budget keeping an SmaWorkspace within `bytes`; a node may sit in
+// both the open list and the leaf index. At least 1, like nodeBudgetForBytes.
+template <int N>
+constexpr size_t smaNodeBudgetForBytes(size_t bytes) {
+    const size_t nodeBytes = sizeof(SmaNode<N>) + 2 * SmaWorkspace<N>::OPEN_ENTRY_BYTES + sizeof(uint32_t);
+    return bytes == 0 ? 0 : std::max<size_t>(1, bytes / nodeBytes);
+}
+
+// Solve `start` with SMA* in at most `nodeBudget` nodes. Like IDA*, it does
+// not terminate on unsolvable boards, so check isSolvable first.
+template <int N, typename Heuristic>
+SearchResult runSMAStar(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                        size_t nodeBudget, SmaWorkspace<N>& workspace) {
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<SmaNode<N>>& nodes = workspace.nodes;
+    std::vector<uint32_t>& freeList = workspace.freeList;
+    std::set<typename SmaWorkspace<N>::OpenEntry>& open = workspace.open;
+    std::set<typename SmaWorkspace<N>::OpenEntry>& leaves = workspace.leaves;
+    nodes.clear();
+    freeList.clear();
+    open.clear();
+    leaves.clear();
+    nodeBudget = std::max<size_t>(nodeBudget, 1);
+
+    SearchResult result;
+    SearchStats& stats = result.stats;
+    size_t peakEntries = 0;
+
+    auto dequeue = [&](uint32_t index) {
+        SmaNode<N>& node = nodes[index];
+        if (node.queued) {
+            open.erase(std::make_tuple(node.key, -int(node.g), index));
+            leaves.erase(std::make_tuple(node.key, -int(node.g), index));
+            node.queued = false;
+        }
+    };
+    // (Re)queue under `key`; call after any change to the node's children
+    auto enqueue = [&](uint32_t index, int key) {
+        dequeue(index);
+        SmaNode<N>& node = nodes[index];
+        node.key = key;
+        node.queued = true;
+        open.insert(std::make_tuple(key, -int(node.g), index));
+        if (node.children == 0 && node.parent != NO_PARENT) {
+            leaves.insert(std::make_tuple(key, -int(node.g), index));
+        }
+        peakEntries = std::max(peakEntries, open.size() + leaves.size());
+    };
+    auto add = [&](const SmaNode<N>& node) {
+        if (!freeList.empty()) {
+            uint32_t index = freeList.back();
+            freeList.pop_back();
+            nodes[index] = node;
+            return index;
+        }
+        nodes.push_back(node);
+        return uint32_t(nodes.size() - 1);
+    };
+    // Drop the worst stored leaf that is not a child of `expanding`; false
+    // when every stored node is on the current path or one of its children
+    auto dropWorstLeaf = [&](uint32_t expanding) {
+        for (auto entry = leaves.rbegin(); entry != leaves.rend(); ++entry) {
+            uint32_t index = std::get<2>(*entry);
+            const SmaNode<N> leaf = nodes[index];
+            if (leaf.parent == expanding) {
+                continue;
+            }
+            dequeue(index);
+            SmaNode<N>& parent = nodes[leaf.parent];
+            dequeue(leaf.parent);
+            parent.children &= uint8_t(~(1u << leaf.slot));
+            parent.forgottenF = std::min(parent.forgottenF, leaf.key);
+            enqueue(leaf.parent, parent.forgottenF);
+            freeList.push_back(index);
+            return true;
+        }
+        return false;
+    };
+
+    int rootH = heuristic.evaluate(start);
+    enqueue(add(SmaNode<N>{start, NO_PARENT, 0, uint16_t(rootH), rootH, INT_MAX, 0, 0, false}), rootH);
+    ++stats.nodesGenerated;
+
+    while (!open.empty()) {
+        uint32_t index = std::get<2>(*open.begin());
+        dequeue(index);
+        if (nodes[index].board == goal) {
+            result.solved = true;
+            for (uint32_t i = index; nodes[i].parent != NO_PARENT; i = nodes[i].parent) {
+                result.moves.push_back(nodes[i].board.blankIndex);
+            }
+            std::reverse(result.moves.begin(), result.moves.end());
+            break;
+        }
+
+        // Children that are not stored, except the parent itself
+        const SmaNode<N> node = nodes[index];
+        const int blank = node.board.blankIndex;
+        const int previousBlank = node.parent == NO_PARENT ? -1 : nodes[node.parent].board.blankIndex;
+        int missing = 0;
+        for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+            missing += !(node.children & (1u << i)) && MOVE_TABLE<N>.neighbors[blank][i] != previousBlank;
+        }
+        while (nodeBudget - nodes.size() + freeList.size() < size_t(missing)) {
+            if (!dropWorstLeaf(index)) {
+                result.budgetExhausted = true;
+                break;
+            }
+        }
+        if (result.budgetExhausted) {
+            break;
+        }
+
+        ++stats.nodesExpanded;
+        for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+            int cell = MOVE_TABLE<N>.neighbors[blank][i];
+            if ((node.children & (1u << i)) || cell == previousBlank) {
+                continue;
+            }
+            int g = node.g + 1;
+            int h = heuristic.afterMove(node.board, node.h, cell);
+            int f = std::max(node.key, g + h);
+            uint32_t child = add(SmaNode<N>{node.board.moved(cell), index, uint16_t(g), uint16_t(h), f, INT_MAX,
+                                            uint8_t(i), 0, false});
+            nodes[index].children |= uint8_t(1u << i);
+            enqueue(child, f);
+            ++stats.nodesGenerated;
+        }
+        nodes[index].forgottenF = INT_MAX;
+        stats.notePeaks(open.size(), nodes.size() - freeList.size());
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.peakBytes = nodes.size() * sizeof(SmaNode<N>) + peakEntries * SmaWorkspace<N>::OPEN_ENTRY_BYTES +
+                      freeList.capacity() * sizeof(uint32_t);
+    return result;
+}
+
+template <int N, typename Heuristic>
+SearchResult runSMAStar(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                        size_t nodeBudget) {
+    SmaWorkspace<N> workspace;
+    return runSMAStar(start, goal, heuristic, nodeBudget, workspace);
+}
+
+// Solve `start` with IDA* ordered by `strategy` after `exhausted` ran out of
+// its node budget. The result keeps budgetExhausted set, sets usedFallback,
+// adds up the work of both attempts and reports the larger of their
+// footprints. `goal` is the goal the first search was after and `heuristic`
+// must be admissible for it. Optimal searches fail over with AStarStrategy;
+// bounded-suboptimal ones pass their weight, so the fallback keeps their
+// bound and does not pay for an optimal solution nobody asked for.
+template <typename Strategy, int N, typename Heuristic>
+SearchResult failOverToIDAStar(const SearchResult& exhausted, const Strategy& strategy, const PuzzleBoard<N>& start,
+                               const PuzzleBoard<N>& goal, const Heuristic& heuristic) {
+    SearchResult result = runIDAStar(strategy, start, goal, heuristic);
+    result.budgetExhausted = true;
+    result.usedFallback = true;
+    result.stats.nodesExpanded += exhausted.stats.nodesExpanded;
+    result.stats.nodesGenerated += exhausted.stats.nodesGenerated;
+    result.stats.seconds += exhausted.stats.seconds;
+    result.stats.peakBytes = std::max(result.stats.peakBytes, exhausted.stats.peakBytes);
+    return result;
+}
+
+template <int N, typename Heuristic>
+SearchResult failOverToIDAStar(const SearchResult& exhausted, const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal,
+                               const Heuristic& heuristic) {
+    return failOverToIDAStar(exhausted, AStarStrategy(), start, goal, heuristic);
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Parent index of a root node
+const uint32_t NO_PARENT = UINT32_MAX;
+
+// Pool owning every node of one search. Nodes are addressed by 32-bit
+// indices, which stay valid as the pool grows (references do not).
+// clear() resets the pool between solves but keeps its capacity, so a
+// warmed-up arena does no further heap allocation.
+template <typename Node>
+struct NodeArena {
+    std::vector<Node> nodes;
+
+    explicit NodeArena(size_t expectedNodes = 1 << 16) {
+        nodes.reserve(expectedNodes);
+    }
+
+    uint32_t add(const Node& node) {
+        nodes.push_back(node);
+        return uint32_t(nodes.size() - 1);
+    }
+
+    Node& operator[](uint32_t index) { return nodes[index]; }
+    const Node& operator[](uint32_t index) const { return nodes[index]; }
+
+    size_t size() const { return nodes.size(); }
+    void clear() { nodes.clear(); }
+};
+
+#endif
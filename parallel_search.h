@@ -0,0 +1,322 @@
+#ifndef PARALLEL_SEARCH_H
+#define PARALLEL_SEARCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bucket_queue.h"
+#include "closed_table.h"
+#include "node_arena.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+#include "thread_pool.h"
+
+// Hash-distributed A* (HDA*, Kishimoto, Fukunaga and Botea). Every board is
+// owned by one partition, chosen by its hash, and each pool worker runs one
+// partition with its own arena, open list and seen-set, so no search
+// structure is shared. A generated child whose owner is another partition
+// is batched and sent to that owner's lock-free inbox.
+//
+// Expansion is not in global f order, so a partition may reach a board at
+// a higher g first; as in A*, a cheaper path reopens it. The best goal found
+// so far (the incumbent) is shared, and nodes with f at or above its cost
+// are pruned. The search ends when no partition has a node left below the
+// incumbent and no batch is in flight, which makes the incumbent optimal
+// for an admissible heuristic. A partition that fills its arena up to
+// MAX_PARALLEL_PARTITION_NODES stops the search with budgetExhausted set.
+
+// Node of one partition. The parent is a ParallelRef, since it may live in
+// another partition; previousBlank is the parent's blank cell, kept here for
+// parent-move pruning because other partitions' arenas cannot be read
+// during the search.
+template <int N>
+struct ParallelNode {
+    PuzzleBoard<N> board;
+    uint32_t parent;
+    uint16_t g;
+    uint16_t h;
+    int8_t previousBlank;  // -1 at the root
+};
+
+// Node reference across partitions: partition in the top bits, arena index
+// in the rest. NO_PARENT cannot collide below 2^27 - 1 nodes per partition,
+// which insertion enforces.
+const int PARALLEL_PARTITION_BITS = 5;
+const int MAX_PARALLEL_PARTITIONS = 1 << PARALLEL_PARTITION_BITS;
+const int PARALLEL_INDEX_BITS = 32 - PARALLEL_PARTITION_BITS;
+const size_t MAX_PARALLEL_PARTITION_NODES = (size_t(1) << PARALLEL_INDEX_BITS) - 1;
+
+inline uint32_t parallelRef(int partition, uint32_t index) {
+    return uint32_t(partition) << PARALLEL_INDEX_BITS | index;
+}
+
+// Batch of nodes sent to one partition
+template <int N>
+struct NodeBatch {
+    NodeBatch* next;
+    std::vector<ParallelNode<N>> nodes;
+};
+
+// Lock-free multi-producer, single-consumer inbox. Producers push batches
+// onto an intrusive stack with compare-and-swap; the consumer takes the
+// whole stack in one exchange, so popped batches are never reused under a
+// producer and there is no ABA problem.
+template <typename Batch>
+struct MpscInbox {
+    std::atomic<Batch*> head{nullptr};
+
+    void push(Batch* batch) {
+        batch->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    Batch* takeAll() { return head.exchange(nullptr, std::memory_order_acquire); }
+};
+
+// Storage of one partition, reused across solves
+template <int N>
+struct alignas(64) ParallelPartition {
+    NodeArena<ParallelNode<N>> nodes;
+    BucketQueue open;
+    BoardTable<N> seen;  // Board -> best g
+    MpscInbox<NodeBatch<N>> inbox;
+    std::vector<std::vector<ParallelNode<N>>> outgoing;  // Unsent nodes per owner
+    SearchStats stats;
+
+    void clear(int partitionCount) {
+        nodes.clear();
+        open.clear();
+        seen.clear();
+        outgoing.resize(partitionCount);
+        stats = SearchStats();
+    }
+
+    size_t bytesUsed() const {
+        return nodes.size() * sizeof(ParallelNode<N>) + seen.slots.size() * sizeof(typename BoardTable<N>::Slot) +
+               open.size() * sizeof(uint32_t);
+    }
+};
+
+template <int N>
+struct ParallelWorkspace {
+    std::vector<std::unique_ptr<ParallelPartition<N>>> partitions;
+
+    size_t bytesUsed() const {
+        size_t bytes = 0;
+        for (const std::unique_ptr<ParallelPartition<N>>& partition : partitions) {
+            bytes += partition->bytesUsed();
+        }
+        return bytes;
+    }
+};
+
+// Partition owning `board`. Uses the high half of the mixed key, since the
+// seen-sets index with the low bits.
+inline int ownerOf(uint64_t mixedKey, int partitionCount) {
+    return int(((mixedKey >> 32) * uint64_t(partitionCount)) >> 32);
+}
+
+// Solve optimally with one partition per pool worker (at most
+// MAX_PARALLEL_PARTITIONS). `heuristic` must be admissible and is shared
+// read-only by all workers.
+template <int N, typename Heuristic>
+SearchResult runParallelAStar(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const Heuristic& heuristic,
+                              ThreadPool& pool, ParallelWorkspace<N>& workspace) {
+    // Expansions between inbox checks, and nodes per batch before a send
+    const int EXPANSIONS_PER_ROUND = 64;
+    const size_t BATCH_NODES = 128;
+
+    auto startTime = std::chrono::steady_clock::now();
+    const int partitionCount = std::min(pool.size(), MAX_PARALLEL_PARTITIONS);
+    std::vector<std::unique_ptr<ParallelPartition<N>>>& partitions = workspace.partitions;
+    while (int(partitions.size()) < partitionCount) {
+        partitions.emplace_back(new ParallelPartition<N>());
+    }
+    for (int p = 0; p < partitionCount; ++p) {
+        ParallelPartition<N>& partition = *partitions[p];
+        partition.clear(partitionCount);
+    }
+
+    // Incumbent goal: its cost is read lock-free, both fields change under the mutex
+    std::atomic<int> bestCost(INT_MAX);
+    uint32_t bestRef = NO_PARENT;
+    std::mutex incumbentMutex;
+
+    // Active workers plus nodes sent but not yet taken in by their owner;
+    // it can only rise while it is nonzero, so zero means the search is over
+    std::atomic<int64_t> outstanding(partitionCount);
+    std::atomic<bool> finished(false);
+    std::atomic<bool> exhausted(false);
+
+    // Take a node into the partition that owns it
+    auto insert = [&](int p, const ParallelNode<N>& node) {
+        ParallelPartition<N>& partition = *partitions[p];
+        if (node.g + node.h >= bestCost.load(std::memory_order_relaxed)) {
+            return;
+        }
+        bool inserted;
+        uint32_t* bestG = partition.seen.findOrInsert(node.board.tiles, node.g, inserted);
+        if (!inserted) {
+            if (node.g >= *bestG) {
+                partition.stats.countDuplicate();
+                return;
+            }
+            *bestG = node.g;
+            partition.stats.countReopening();
+        }
+        if (partition.nodes.size() >= MAX_PARALLEL_PARTITION_NODES) {
+            exhausted.store(true);
+            finished.store(true, std::memory_order_release);
+            return;
+        }
+        uint32_t index = partition.nodes.add(node);
+        if (node.board == goal) {
+            std::lock_guard<std::mutex> lock(incumbentMutex);
+            if (node.g < bestCost.load(std::memory_order_relaxed)) {
+                bestCost.store(node.g);
+                bestRef = parallelRef(p, index);
+            }
+        } else {
+            partition.open.push(node.g + node.h, index);
+        }
+    };
+
+    auto flush = [&](ParallelPartition<N>& partition, int owner) {
+        std::vector<ParallelNode<N>>& pending = partition.outgoing[owner];
+        if (pending.empty()) {
+            return;
+        }
+        NodeBatch<N>* batch = new NodeBatch<N>();
+        batch->nodes.swap(pending);
+        outstanding.fetch_add(int64_t(batch->nodes.size()));
+        partitions[owner]->inbox.push(batch);
+    };
+
+    auto work = [&](int, size_t worker) {
+        const int p = int(worker);
+        ParallelPartition<N>& partition = *partitions[p];
+        bool idle = false;
+        while (!finished.load(std::memory_order_acquire)) {
+            for (NodeBatch<N>* batch = partition.inbox.takeAll(); batch != nullptr;) {
+                if (idle) {
+                    outstanding.fetch_add(1);
+                    idle = false;
+                }
+                for (const ParallelNode<N>& node : batch->nodes) {
+                    insert(p, node);
+                }
+                outstanding.fetch_sub(int64_t(batch->nodes.size()));
+                NodeBatch<N>* next = batch->next;
+                delete batch;
+                batch = next;
+            }
+
+            int expansions = 0;
+            while (expansions < EXPANSIONS_PER_ROUND && !partition.open.empty()) {
+                if (partition.open.topKey() >= bestCost.load(std::memory_order_relaxed)) {
+                    partition.open.clear();
+                    break;
+                }
+                uint32_t index = partition.open.pop();
+                const ParallelNode<N> node = partition.nodes[index];
+                if (node.g > *partition.seen.find(node.board.tiles)) {
+                    continue;
+                }
+                ++expansions;
+                ++partition.stats.nodesExpanded;
+
+                SuccessorBuffer<N> successors;
+                generateSuccessors(node.board, node.previousBlank, successors);
+                for (int i = 0; i < successors.count; ++i) {
+                    const PuzzleBoard<N>& child = successors.boards[i];
+                    ParallelNode<N> next = {child, parallelRef(p, index), uint16_t(node.g + 1),
+                                            uint16_t(heuristic.afterMove(node.board, node.h, successors.cells[i])),
+                                            int8_t(node.board.blankIndex)};
+                    ++partition.stats.nodesGenerated;
+                    int owner = ownerOf(mixBoardKey(child.tiles), partitionCount);
+                    if (owner == p) {
+                        insert(p, next);
+                    } else {
+                        partition.outgoing[owner].push_back(next);
+                        if (partition.outgoing[owner].size() >= BATCH_NODES) {
+                            flush(partition, owner);
+                        }
+                    }
+                }
+                partition.stats.notePeaks(partition.open.size(), partition.seen.size());
+            }
+            for (int owner = 0; owner < partitionCount; ++owner) {
+                flush(partition, owner);
+            }
+
+            if (partition.open.empty()) {
+                if (!idle) {
+                    idle = true;
+                    outstanding.fetch_sub(1);
+                }
+                if (outstanding.load() == 0) {
+                    finished.store(true, std::memory_order_release);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    SearchResult result;
+    if (start == goal) {
+        result.solved = true;
+        return result;
+    }
+    insert(ownerOf(mixBoardKey(start.tiles), partitionCount),
+           ParallelNode<N>{start, NO_PARENT, 0, uint16_t(heuristic.evaluate(start)), -1});
+    pool.run(size_t(partitionCount), work);
+    // A search stopped early may leave batches in the inboxes
+    for (int p = 0; p < partitionCount; ++p) {
+        for (NodeBatch<N>* batch = partitions[p]->inbox.takeAll(); batch != nullptr;) {
+            NodeBatch<N>* next = batch->next;
+            delete batch;
+            batch = next;
+        }
+    }
+
+    SearchStats& stats = result.stats;
+    stats.nodesGenerated = 1;
+    for (int p = 0; p < partitionCount; ++p) {
+        const SearchStats& local = partitions[p]->stats;
+        stats.nodesExpanded += local.nodesExpanded;
+        stats.nodesGenerated += local.nodesGenerated;
+        stats.duplicatesRejected += local.duplicatesRejected;
+        stats.reopenings += local.reopenings;
+        stats.peakOpen += local.peakOpen;
+        stats.peakClosed += local.peakClosed;
+    }
+    if (exhausted.load()) {
+        // The incumbent, if any, is not proven optimal
+        result.budgetExhausted = true;
+    } else if (bestRef != NO_PARENT) {
+        result.solved = true;
+        for (uint32_t ref = bestRef; ref != NO_PARENT;) {
+            const ParallelNode<N>& node = partitions[ref >> PARALLEL_INDEX_BITS]->nodes[ref & ((1u << PARALLEL_INDEX_BITS) - 1)];
+            if (node.parent == NO_PARENT) {
+                break;
+            }
+            result.moves.push_back(node.board.blankIndex);
+            ref = node.parent;
+        }
+        std::reverse(result.moves.begin(), result.moves.end());
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    stats.peakBytes = workspace.bytesUsed();
+    return result;
+}
+
+#endif
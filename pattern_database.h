@@ -0,0 +1,177 @@
+#ifndef PATTERN_DATABASE_H
+#define PATTERN_DATABASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "mapped_file.h"
+#include "permutation_rank.h"
+#include "puzzle_board.h"
+
+// On-disk layout of an additive pattern database (all fields little-endian):
+//   PdbFileHeader
+//   PdbPatternHeader[patternCount]
+//   one distance table per pattern at its dataOffset (8-byte aligned)
+// Each table holds one 4-bit or 8-bit distance per ranked placement of the
+// pattern's tiles. Distances count only moves of that pattern's tiles, so the
+// lookups of disjoint patterns add up to an admissible heuristic. Tables are
+// built for the blank-last goal.
+const char PDB_MAGIC[4] = {'P', 'D', 'B', '1'};
+const int PDB_MAX_PATTERN_TILES = 15;
+
+struct PdbFileHeader {
+    char magic[4];
+    uint8_t width;
+    uint8_t patternCount;
+    uint8_t bitsPerEntry;  // 4 or 8
+    uint8_t reserved;
+};
+
+struct PdbPatternHeader {
+    uint8_t tileCount;
+    uint8_t tiles[PDB_MAX_PATTERN_TILES];
+    uint64_t entryCount;
+    uint64_t dataOffset;
+};
+
+// Read-only view of a pattern database file mapped into memory. Loading only
+// validates headers, so startup cost does not depend on the table size.
+template <int N>
+struct PatternDatabase {
+    struct Pattern {
+        int tileCount;
+        uint8_t tiles[PDB_MAX_PATTERN_TILES];
+        const uint8_t* data;
+    };
+
+    std::vector<Pattern> patterns;
+    int8_t patternOf[N * N];  // Pattern index of each tile, -1 if none
+    int bitsPerEntry;
+    MappedFile file;
+
+    PatternDatabase() : bitsPerEntry(0) {
+        memset(patternOf, -1, sizeof(patternOf));
+    }
+
+    bool loaded() const { return file.isOpen(); }
+
+    // Map `path`; returns false (leaving the database empty) if the file is
+    // missing, malformed, built for another board width or has patterns that
+    // do not cover every tile
+    bool load(const char* path) {
+        unload();
+        if (!file.open(path, sizeof(PdbFileHeader))) {
+            return false;
+        }
+        if (!parse()) {
+            unload();
+            return false;
+        }
+        return true;
+    }
+
+    void unload() {
+        file.close();
+        patterns.clear();
+        memset(patternOf, -1, sizeof(patternOf));
+    }
+
+    int entry(const Pattern& pattern, uint64_t rank) const {
+        if (bitsPerEntry == 4) {
+            return (pattern.data[rank >> 1] >> ((rank & 1) * 4)) & 0xF;
+        }
+        return pattern.data[rank];
+    }
+
+    // Distance of one pattern given the cell of every tile
+    int lookup(int pattern, const uint8_t tileCells[]) const {
+        const Pattern& p = patterns[pattern];
+        uint8_t positions[PDB_MAX_PATTERN_TILES];
+        for (int i = 0; i < p.tileCount; ++i) {
+            positions[i] = tileCells[p.tiles[i]];
+        }
+        return entry(p, rankPattern(positions, p.tileCount, N * N));
+    }
+
+    int evaluate(const PuzzleBoard<N>& board) const {
+        uint8_t tileCells[N * N];
+        for (int cell = 0; cell < N * N; ++cell) {
+            tileCells[board.tileAt(cell)] = uint8_t(cell);
+        }
+        int total = 0;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            total += lookup(int(i), tileCells);
+        }
+        return total;
+    }
+
+    // Only the pattern owning the moved tile changes its lookup
+    int afterMove(const PuzzleBoard<N>& board, int h, int cell) const {
+        int pattern = patternOf[board.tileAt(cell)];
+        if (pattern < 0) {
+            return h;
+        }
+        uint8_t tileCells[N * N];
+        for (int i = 0; i < N * N; ++i) {
+            tileCells[board.tileAt(i)] = uint8_t(i);
+        }
+        int before = lookup(pattern, tileCells);
+        tileCells[board.tileAt(cell)] = board.blankIndex;
+        return h - before + lookup(pattern, tileCells);
+    }
+
+private:
+    bool parse() {
+        const uint8_t* base = file.data;
+        const size_t mappingSize = file.size;
+        PdbFileHeader header;
+        memcpy(&header, base, sizeof(header));
+        if (memcmp(header.magic, PDB_MAGIC, sizeof(PDB_MAGIC)) != 0 || header.width != N ||
+            (header.bitsPerEntry != 4 && header.bitsPerEntry != 8)) {
+            return false;
+        }
+        if (sizeof(PdbFileHeader) + header.patternCount * sizeof(PdbPatternHeader) > mappingSize) {
+            return false;
+        }
+        bitsPerEntry = header.bitsPerEntry;
+
+        for (int i = 0; i < header.patternCount; ++i) {
+            PdbPatternHeader patternHeader;
+            memcpy(&patternHeader, base + sizeof(PdbFileHeader) + i * sizeof(PdbPatternHeader), sizeof(patternHeader));
+            if (patternHeader.tileCount == 0 || patternHeader.tileCount > PDB_MAX_PATTERN_TILES ||
+                patternHeader.entryCount != patternEntryCount(N * N, patternHeader.tileCount)) {
+                return false;
+            }
+            uint64_t bytes = bitsPerEntry == 4 ? (patternHeader.entryCount + 1) / 2 : patternHeader.entryCount;
+            // Written so a huge offset cannot wrap around past the check
+            if (patternHeader.dataOffset > mappingSize || bytes > mappingSize - patternHeader.dataOffset) {
+                return false;
+            }
+
+            Pattern pattern;
+            pattern.tileCount = patternHeader.tileCount;
+            for (int t = 0; t < pattern.tileCount; ++t) {
+                int tile = patternHeader.tiles[t];
+                if (tile <= 0 || tile >= N * N || patternOf[tile] >= 0) {
+                    return false;
+                }
+                pattern.tiles[t] = uint8_t(tile);
+                patternOf[tile] = int8_t(i);
+            }
+            pattern.data = base + patternHeader.dataOffset;
+            patterns.push_back(pattern);
+        }
+        // The patterns must split up every tile, or boards off the goal can
+        // look solved and the heuristic is weaker than it needs to be
+        for (int tile = 1; tile < N * N; ++tile) {
+            if (patternOf[tile] < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,233 @@
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "pattern_database.h"
+#include "puzzle_board.h"
+
+using namespace std;
+
+// Offline builder for additive pattern databases.
+//
+//   pdb_builder <width> <output-file> <tiles>[/<tiles>...]
+//
+// e.g. pdb_builder 4 fifteen-663.pdb 1,5,6,9,10,13/7,8,11,12,14,15/2,3,4
+//
+// The patterns must split up all N*N-1 tiles between them.
+//
+// Each pattern is solved by a 0-1 breadth-first search backwards from the
+// blank-last goal over (pattern tile cells, blank cell): moving a pattern
+// tile costs 1, moving any other tile costs 0. The stored distance of a
+// placement is the minimum over blank cells.
+
+// Distances of every placement of one pattern
+template <int N>
+vector<uint8_t> buildPattern(const vector<int>& tiles) {
+    const int cells = N * N;
+    const int tileCount = int(tiles.size());
+    const uint64_t entries = patternEntryCount(cells, tileCount);
+    const PuzzleBoard<N> goal = blankLastGoal<N>();
+
+    // Search state = rank * cells + blank cell
+    vector<uint8_t> distance(entries * cells, 0xFF);
+    deque<uint64_t> frontier;
+
+    uint8_t positions[PDB_MAX_PATTERN_TILES];
+    for (int i = 0; i < tileCount; ++i) {
+        positions[i] = uint8_t(tiles[i] - 1);
+    }
+    uint64_t start = rankPattern(positions, tileCount, cells) * cells + goal.blankIndex;
+    distance[start] = 0;
+    frontier.push_back(start);
+
+    while (!frontier.empty()) {
+        uint64_t state = frontier.front();
+        frontier.pop_front();
+        uint64_t rank = state / cells;
+        int blank = int(state % cells);
+        int d = distance[state];
+
+        unrankPattern(rank, tileCount, cells, positions);
+        int occupant[N * N];
+        memset(occupant, -1, sizeof(occupant));
+        for (int i = 0; i < tileCount; ++i) {
+            occupant[positions[i]] = i;
+        }
+
+        for (int m = 0; m < MOVE_TABLE<N>.count[blank]; ++m) {
+            int cell = MOVE_TABLE<N>.neighbors[blank][m];
+            int tile = occupant[cell];
+            uint64_t next;
+            int cost;
+            if (tile >= 0) {
+                positions[tile] = uint8_t(blank);
+                next = rankPattern(positions, tileCount, cells) * cells + cell;
+                positions[tile] = uint8_t(cell);
+                cost = 1;
+            } else {
+                next = rank * cells + cell;
+                cost = 0;
+            }
+            if (distance[next] > d + cost) {
+                distance[next] = uint8_t(d + cost);
+                if (cost == 0) {
+                    frontier.push_front(next);
+                } else {
+                    frontier.push_back(next);
+                }
+            }
+        }
+    }
+
+    vector<uint8_t> table(entries, 0xFF);
+    for (uint64_t rank = 0; rank < entries; ++rank) {
+        for (int blank = 0; blank < cells; ++blank) {
+            if (distance[rank * cells + blank] < table[rank]) {
+                table[rank] = distance[rank * cells + blank];
+            }
+        }
+    }
+    return table;
+}
+
+template <int N>
+bool buildDatabase(const vector<vector<int>>& patterns, const char* path) {
+    vector<vector<uint8_t>> tables;
+    int maxDistance = 0;
+    for (const vector<int>& tiles : patterns) {
+        cout << "Building pattern of " << tiles.size() << " tiles..." << endl;
+        tables.push_back(buildPattern<N>(tiles));
+        for (uint8_t d : tables.back()) {
+            if (d != 0xFF && d > maxDistance) {
+                maxDistance = d;
+            }
+        }
+    }
+    // Unreached placements (only possible when a pattern holds every tile)
+    // keep 0xFF; nibbles stay exact as long as real distances are below 15
+    int bitsPerEntry = maxDistance < 15 ? 4 : 8;
+
+    PdbFileHeader header;
+    memcpy(header.magic, PDB_MAGIC, sizeof(PDB_MAGIC));
+    header.width = uint8_t(N);
+    header.patternCount = uint8_t(patterns.size());
+    header.bitsPerEntry = uint8_t(bitsPerEntry);
+    header.reserved = 0;
+
+    FILE* out = fopen(path, "wb");
+    if (out == NULL) {
+        return false;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+
+    uint64_t offset = sizeof(PdbFileHeader) + patterns.size() * sizeof(PdbPatternHeader);
+    vector<vector<uint8_t>> packed;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        offset = (offset + 7) & ~uint64_t(7);
+
+        PdbPatternHeader patternHeader;
+        memset(&patternHeader, 0, sizeof(patternHeader));
+        patternHeader.tileCount = uint8_t(patterns[i].size());
+        for (size_t t = 0; t < patterns[i].size(); ++t) {
+            patternHeader.tiles[t] = uint8_t(patterns[i][t]);
+        }
+        patternHeader.entryCount = tables[i].size();
+        patternHeader.dataOffset = offset;
+        fwrite(&patternHeader, sizeof(patternHeader), 1, out);
+
+        if (bitsPerEntry == 4) {
+            vector<uint8_t> nibbles((tables[i].size() + 1) / 2, 0);
+            for (size_t r = 0; r < tables[i].size(); ++r) {
+                nibbles[r >> 1] |= uint8_t((tables[i][r] & 0xF) << ((r & 1) * 4));
+            }
+            packed.push_back(nibbles);
+        } else {
+            packed.push_back(tables[i]);
+        }
+        offset += packed.back().size();
+    }
+
+    long position = long(sizeof(PdbFileHeader) + patterns.size() * sizeof(PdbPatternHeader));
+    for (const vector<uint8_t>& data : packed) {
+        while (position % 8 != 0) {
+            fputc(0, out);
+            ++position;
+        }
+        fwrite(data.data(), 1, data.size(), out);
+        position += long(data.size());
+    }
+
+    bool ok = ferror(out) == 0;
+    ok = fclose(out) == 0 && ok;
+    cout << "Wrote " << path << " (" << bitsPerEntry << "-bit entries, max distance " << maxDistance << ")" << endl;
+    return ok;
+}
+
+// Parse "1,2,3/4,5,6" into tile lists, checking each tile is used exactly once
+bool parsePatterns(const string& text, int cells, vector<vector<int>>& patterns) {
+    vector<bool> seen(cells, false);
+    patterns.assign(1, vector<int>());
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == '/') {
+            patterns.push_back(vector<int>());
+            ++i;
+        } else if (text[i] == ',') {
+            ++i;
+        } else if (!isdigit((unsigned char)text[i])) {
+            return false;
+        } else {
+            size_t end = i;
+            int tile = stoi(text.substr(i), &end);
+            i += end;
+            if (tile <= 0 || tile >= cells || seen[tile]) {
+                return false;
+            }
+            seen[tile] = true;
+            patterns.back().push_back(tile);
+        }
+    }
+    for (const vector<int>& tiles : patterns) {
+        if (tiles.empty() || int(tiles.size()) > PDB_MAX_PATTERN_TILES) {
+            return false;
+        }
+    }
+    for (int tile = 1; tile < cells; ++tile) {
+        if (!seen[tile]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        cerr << "usage: " << argv[0] << " <width> <output-file> <tiles>[/<tiles>...]" << endl;
+        return 1;
+    }
+
+    int width = atoi(argv[1]);
+    vector<vector<int>> patterns;
+    if (width < 2 || width > 5 || !parsePatterns(argv[3], width * width, patterns)) {
+        cerr << "invalid width or pattern list (every tile must be in exactly one pattern)" << endl;
+        return 1;
+    }
+
+    bool ok = false;
+    switch (width) {
+        case 2: ok = buildDatabase<2>(patterns, argv[2]); break;
+        case 3: ok = buildDatabase<3>(patterns, argv[2]); break;
+        case 4: ok = buildDatabase<4>(patterns, argv[2]); break;
+        case 5: ok = buildDatabase<5>(patterns, argv[2]); break;
+    }
+    if (!ok) {
+        cerr << "could not write " << argv[2] << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef PERMUTATION_RANK_H
+#define PERMUTATION_RANK_H
+
+#include <cstdint>
+
+// Perfect hashing of partial permutations: the cells of k distinct tiles on
+// an n-cell board map one-to-one onto 0 .. n!/(n-k)! - 1. Pattern databases
+// rank the cells of a pattern's tiles; the solution table ranks all but the
+// last two tiles, which leaves one solvable board per rank.
+
+// Up to all but two tiles of a 5x5 board
+const int MAX_RANKED_TILES = 23;
+
+// Number of placements of `tileCount` distinct tiles on `cells` cells
+inline uint64_t patternEntryCount(int cells, int tileCount) {
+    uint64_t count = 1;
+    for (int i = 0; i < tileCount; ++i) {
+        count *= uint64_t(cells - i);
+    }
+    return count;
+}
+
+// Rank of a placement (positions[i] is the cell of the pattern's i-th tile)
+// in the mixed radix cells * (cells - 1) * ... of its free-cell indices
+inline uint64_t rankPattern(const uint8_t positions[], int tileCount, int cells) {
+    uint64_t rank = 0;
+    for (int i = 0; i < tileCount; ++i) {
+        int smaller = 0;
+        for (int j = 0; j < i; ++j) {
+            smaller += positions[j] < positions[i];
+        }
+        rank = rank * uint64_t(cells - i) + uint64_t(positions[i] - smaller);
+    }
+    return rank;
+}
+
+inline void unrankPattern(uint64_t rank, int tileCount, int cells, uint8_t positions[]) {
+    int digits[MAX_RANKED_TILES];
+    for (int i = tileCount - 1; i >= 0; --i) {
+        digits[i] = int(rank % uint64_t(cells - i));
+        rank /= uint64_t(cells - i);
+    }
+    bool used[32] = {};
+    for (int i = 0; i < tileCount; ++i) {
+        int cell = 0;
+        for (int skip = digits[i]; used[cell] || skip > 0; ++cell) {
+            if (!used[cell]) {
+                --skip;
+            }
+        }
+        used[cell] = true;
+        positions[i] = uint8_t(cell);
+    }
+}
+
+#endif
@@ -0,0 +1,444 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <benchmark/benchmark.h>
+
+#include "best_first_search.h"
+#include "bidirectional_search.h"
+#include "closed_table.h"
+#include "greedy_search.h"
+#include "heuristics.h"
+#include "ida_star.h"
+#include "memory_bounded_search.h"
+#include "parallel_search.h"
+#include "puzzle_board.h"
+#include "search_strategy.h"
+#include "simd_heuristics.h"
+#include "walking_distance.h"
+
+using namespace std;
+
+// Benchmarks over fixed, seeded instance sets, so numbers are comparable
+// between builds. Run with --benchmark_format=json (or --benchmark_out=<file>
+// --benchmark_out_format=json) to record a baseline for regression checks.
+//
+// Solve benchmarks report nodes/sec, ns/expansion, peak_bytes (the search
+// workspace of the largest solve) and max_rss_kb (the process high-water mark).
+
+const uint32_t INSTANCE_SEED = 20240601;
+const int INSTANCE_COUNT = 32;
+
+// The two 8-puzzle positions that need 31 moves, the most of any
+const int HARDEST_8_PUZZLES[2][9] = {
+    {8, 6, 7, 2, 5, 4, 3, 0, 1},
+    {6, 4, 7, 8, 5, 0, 3, 2, 1},
+};
+
+// `count` boards `depth` random moves from the blank-last goal, never undoing
+// the previous move. The optimal distance is at most `depth`.
+template <int N>
+vector<PuzzleBoard<N>> randomWalkInstances(int depth, int count, uint32_t seed) {
+    mt19937 random(seed + uint32_t(depth) * 7919u + uint32_t(N));
+    vector<PuzzleBoard<N>> boards;
+    for (int i = 0; i < count; ++i) {
+        PuzzleBoard<N> board = blankLastGoal<N>();
+        int previousBlank = -1;
+        for (int step = 0; step < depth; ++step) {
+            int blank = board.blankIndex;
+            int cell;
+            do {
+                cell = MOVE_TABLE<N>.neighbors[blank][random() % MOVE_TABLE<N>.count[blank]];
+            } while (cell == previousBlank);
+            previousBlank = blank;
+            board = board.moved(cell);
+        }
+        boards.push_back(board);
+    }
+    return boards;
+}
+
+vector<PuzzleBoard<3>> hardestInstances() {
+    vector<PuzzleBoard<3>> boards;
+    for (const int* cells : HARDEST_8_PUZZLES) {
+        boards.push_back(PuzzleBoard<3>::fromCells(cells));
+    }
+    return boards;
+}
+
+// Instance set selected by a benchmark argument: a random-walk depth, or 0
+// for the hardest 8-puzzles
+template <int N>
+vector<PuzzleBoard<N>> instanceSet(int depth) {
+    if constexpr (N == 3) {
+        if (depth == 0) {
+            return hardestInstances();
+        }
+    }
+    return randomWalkInstances<N>(depth, INSTANCE_COUNT, INSTANCE_SEED);
+}
+
+long maxResidentKilobytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// `seconds` is the search time the engines measured, excluding harness overhead
+void reportSearchCounters(benchmark::State& state, uint64_t expanded, double seconds, size_t peakBytes) {
+    state.counters["nodes/sec"] = benchmark::Counter(double(expanded), benchmark::Counter::kIsRate);
+    state.counters["ns/expansion"] = expanded > 0 ? seconds * 1e9 / double(expanded) : 0;
+    state.counters["peak_bytes"] = double(peakBytes);
+    state.counters["max_rss_kb"] = double(maxResidentKilobytes());
+}
+
+// Micro-benchmarks
+
+template <int N>
+void BM_ManhattanEvaluate(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            benchmark::DoNotOptimize(heuristic.evaluate(board));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(boards.size()));
+}
+BENCHMARK_TEMPLATE(BM_ManhattanEvaluate, 3);
+BENCHMARK_TEMPLATE(BM_ManhattanEvaluate, 4);
+
+template <int N>
+void BM_MisplacedEvaluate(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    MisplacedTilesHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            benchmark::DoNotOptimize(heuristic.evaluate(board));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(boards.size()));
+}
+BENCHMARK_TEMPLATE(BM_MisplacedEvaluate, 3);
+BENCHMARK_TEMPLATE(BM_MisplacedEvaluate, 4);
+
+// Full evaluation of a batch of boards with the SIMD kernels at one level
+// (argument: 0 scalar, 1 SSSE3, 2 AVX2), and the table loop they replace
+template <SimdKernel Kernel, int N>
+void BM_SimdEvaluateBatch(benchmark::State& state) {
+    SimdLevel level = SimdLevel(state.range(0));
+    if (level > detectSimdLevel()) {
+        state.SkipWithError("SIMD level not supported by this CPU");
+        return;
+    }
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    vector<int> values(boards.size());
+    for (auto _ : state) {
+        evaluateBoards<Kernel>(level, boards.data(), boards.size(), BLANK_LAST_TABLES<N>.simd, values.data());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetLabel(simdLevelName(level));
+    state.SetItemsProcessed(state.iterations() * int64_t(boards.size()));
+}
+BENCHMARK_TEMPLATE(BM_SimdEvaluateBatch, SimdKernel::MANHATTAN, 3)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_SimdEvaluateBatch, SimdKernel::MANHATTAN, 4)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_SimdEvaluateBatch, SimdKernel::MISPLACED, 4)->DenseRange(0, 2);
+
+template <int N>
+void BM_TableManhattanBatch(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    vector<int> values(boards.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < boards.size(); ++i) {
+            values[i] = manhattanDistance(boards[i], BLANK_LAST_TABLES<N>);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(boards.size()));
+}
+BENCHMARK_TEMPLATE(BM_TableManhattanBatch, 3);
+BENCHMARK_TEMPLATE(BM_TableManhattanBatch, 4);
+
+// Incremental update, the form the engines use per child
+template <int N>
+void BM_ManhattanAfterMove(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    int64_t children = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            int blank = board.blankIndex;
+            for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+                benchmark::DoNotOptimize(heuristic.afterMove(board, 20, MOVE_TABLE<N>.neighbors[blank][i]));
+            }
+            children += MOVE_TABLE<N>.count[blank];
+        }
+    }
+    state.SetItemsProcessed(children);
+}
+BENCHMARK_TEMPLATE(BM_ManhattanAfterMove, 3);
+BENCHMARK_TEMPLATE(BM_ManhattanAfterMove, 4);
+
+// All successors of each board scored in one batch call, to compare with
+// the incremental update above
+template <int N>
+void BM_ManhattanSuccessorBatch(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    int64_t children = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SuccessorBuffer<N> successors;
+            generateSuccessors(board, -1, successors);
+            int values[4];
+            heuristic.evaluateBatch(successors.boards, size_t(successors.count), values);
+            benchmark::DoNotOptimize(values);
+            children += successors.count;
+        }
+    }
+    state.SetItemsProcessed(children);
+}
+BENCHMARK_TEMPLATE(BM_ManhattanSuccessorBatch, 3);
+BENCHMARK_TEMPLATE(BM_ManhattanSuccessorBatch, 4);
+
+template <int N>
+void BM_SuccessorGeneration(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    int64_t children = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            int blank = board.blankIndex;
+            for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+                PuzzleBoard<N> child = board.moved(MOVE_TABLE<N>.neighbors[blank][i]);
+                benchmark::DoNotOptimize(child);
+            }
+            children += MOVE_TABLE<N>.count[blank];
+        }
+    }
+    state.SetItemsProcessed(children);
+}
+BENCHMARK_TEMPLATE(BM_SuccessorGeneration, 3);
+BENCHMARK_TEMPLATE(BM_SuccessorGeneration, 4);
+BENCHMARK_TEMPLATE(BM_SuccessorGeneration, 5);
+
+template <int N>
+void BM_BoardHash(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(40, 256, INSTANCE_SEED);
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            benchmark::DoNotOptimize(mixBoardKey(board.tiles));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(boards.size()));
+}
+BENCHMARK_TEMPLATE(BM_BoardHash, 3);
+BENCHMARK_TEMPLATE(BM_BoardHash, 5);
+
+// Insert then probe a seen-set of the size a mid-sized solve builds
+template <int N>
+void BM_ClosedTableInsert(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = randomWalkInstances<N>(60, int(state.range(0)), INSTANCE_SEED);
+    BoardTable<N> table;
+    for (auto _ : state) {
+        table.clear();
+        for (const PuzzleBoard<N>& board : boards) {
+            benchmark::DoNotOptimize(table.insert(board.tiles));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(boards.size()));
+}
+BENCHMARK_TEMPLATE(BM_ClosedTableInsert, 4)->Arg(1 << 12)->Arg(1 << 16);
+
+// End-to-end solves over one instance set per argument
+
+template <typename Strategy, int N, typename Heuristic>
+void solveInstanceSet(benchmark::State& state, const Heuristic& heuristic) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    SearchWorkspace<N> workspace;
+    uint64_t expanded = 0;
+    double seconds = 0;
+    size_t peakBytes = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SearchResult result = runBestFirstSearch<Strategy>(board, blankLastGoal<N>(), heuristic, workspace);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+            if (workspace.bytesUsed() > peakBytes) {
+                peakBytes = workspace.bytesUsed();
+            }
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, peakBytes);
+}
+
+template <typename Strategy, int N>
+void BM_SolveManhattan(benchmark::State& state) {
+    solveInstanceSet<Strategy, N>(state, ManhattanHeuristic<N>(BLANK_LAST_TABLES<N>));
+}
+
+template <typename Strategy, int N>
+void BM_SolveMisplaced(benchmark::State& state) {
+    solveInstanceSet<Strategy, N>(state, MisplacedTilesHeuristic<N>(BLANK_LAST_TABLES<N>));
+}
+
+template <typename Strategy, int N>
+void BM_SolveLinearConflict(benchmark::State& state) {
+    solveInstanceSet<Strategy, N>(state, LinearConflictHeuristic<N>(BLANK_LAST_TABLES<N>));
+}
+
+template <typename Strategy, int N>
+void BM_SolveWalkingDistance(benchmark::State& state) {
+    solveInstanceSet<Strategy, N>(state, WalkingDistanceHeuristic<N>(BLANK_LAST_TABLES<N>));
+}
+
+// Lazy greedy search and enforced hill-climbing with Manhattan
+template <int N>
+void BM_SolveGreedy(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    GreedyWorkspace<N> workspace;
+    uint64_t expanded = 0;
+    double seconds = 0;
+    size_t peakBytes = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SearchResult result = state.range(1) == 0 ? runGreedySearch(board, blankLastGoal<N>(), heuristic, workspace)
+                                                      : runEnforcedHillClimbing(board, blankLastGoal<N>(), heuristic, workspace);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+            peakBytes = max(peakBytes, size_t(result.stats.peakBytes));
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, peakBytes);
+}
+
+template <int N>
+void BM_SolveIDAStar(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    uint64_t expanded = 0;
+    double seconds = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SearchResult result = runIDAStar(board, blankLastGoal<N>(), heuristic);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, 0);
+}
+
+// SMA* with a pool of 4096 nodes, to show what forgetting leaves costs
+template <int N>
+void BM_SolveSMAStar(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    SmaWorkspace<N> workspace;
+    uint64_t expanded = 0;
+    double seconds = 0;
+    size_t peakBytes = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SearchResult result = runSMAStar(board, blankLastGoal<N>(), heuristic, 4096, workspace);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+            peakBytes = max(peakBytes, size_t(result.stats.peakBytes));
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, peakBytes);
+}
+
+// HDA* over an instance set (first argument) on a pool of workers (second)
+template <int N>
+void BM_SolveParallelAStar(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    ManhattanHeuristic<N> heuristic(BLANK_LAST_TABLES<N>);
+    ThreadPool pool(int(state.range(1)));
+    ParallelWorkspace<N> workspace;
+    uint64_t expanded = 0;
+    double seconds = 0;
+    size_t peakBytes = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SearchResult result = runParallelAStar(board, blankLastGoal<N>(), heuristic, pool, workspace);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+            peakBytes = max(peakBytes, size_t(result.stats.peakBytes));
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, peakBytes);
+}
+
+// Bidirectional engines over the same sets; MM uses Manhattan both ways
+template <int N>
+void BM_SolveBidirectionalBFS(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    BidirectionalWorkspace<N> workspace;
+    uint64_t expanded = 0;
+    double seconds = 0;
+    size_t peakBytes = 0;
+    for (auto _ : state) {
+        for (const PuzzleBoard<N>& board : boards) {
+            SearchResult result = runBidirectionalBFS(board, blankLastGoal<N>(), workspace);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+            peakBytes = max(peakBytes, workspace.bytesUsed());
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, peakBytes);
+}
+
+template <int N>
+void BM_SolveMeetInTheMiddle(benchmark::State& state) {
+    vector<PuzzleBoard<N>> boards = instanceSet<N>(int(state.range(0)));
+    vector<HeuristicTables<N>> startTables;
+    for (const PuzzleBoard<N>& board : boards) {
+        startTables.emplace_back(board);
+    }
+    ManhattanHeuristic<N> toGoal(BLANK_LAST_TABLES<N>);
+    BidirectionalWorkspace<N> workspace;
+    uint64_t expanded = 0;
+    double seconds = 0;
+    size_t peakBytes = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < boards.size(); ++i) {
+            SearchResult result = runMeetInTheMiddle(boards[i], blankLastGoal<N>(), toGoal,
+                                                     ManhattanHeuristic<N>(startTables[i]), workspace);
+            expanded += result.stats.nodesExpanded;
+            seconds += result.stats.seconds;
+            peakBytes = max(peakBytes, workspace.bytesUsed());
+        }
+    }
+    reportSearchCounters(state, expanded, seconds, peakBytes);
+}
+
+// 8-puzzle: random walks of 10/20/30 moves and the hardest (argument 0)
+#define EIGHT_PUZZLE_SETS ->Arg(10)->Arg(20)->Arg(30)->Arg(0)->Unit(benchmark::kMillisecond)
+
+BENCHMARK_TEMPLATE(BM_SolveManhattan, AStarStrategy, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveManhattan, WeightedAStarStrategy<2>, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveManhattan, GreedyStrategy, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveMisplaced, AStarStrategy, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveMisplaced, GreedyStrategy, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveGreedy, 3)->ArgsProduct({{10, 20, 30, 0}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveLinearConflict, AStarStrategy, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveWalkingDistance, AStarStrategy, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveIDAStar, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveSMAStar, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveBidirectionalBFS, 3) EIGHT_PUZZLE_SETS;
+BENCHMARK_TEMPLATE(BM_SolveMeetInTheMiddle, 3) EIGHT_PUZZLE_SETS;
+
+// 15-puzzle random walks, deep enough to stress the open list
+BENCHMARK_TEMPLATE(BM_SolveManhattan, AStarStrategy, 4)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveLinearConflict, AStarStrategy, 4)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveWalkingDistance, AStarStrategy, 4)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveManhattan, WeightedAStarStrategy<2>, 4)->Arg(30)->Arg(60)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveManhattan, GreedyStrategy, 4)->Arg(30)->Arg(60)->Arg(200)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveGreedy, 4)->ArgsProduct({{30, 60, 200}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveIDAStar, 4)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SolveParallelAStar, 4)->ArgsProduct({{30}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SolveMeetInTheMiddle, 4)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,202 @@
+#ifndef PUZZLE_BOARD_H
+#define PUZZLE_BOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Packed storage for an N x N board: 4-bit cells in one 64-bit word up to
+// 4x4, 5-bit cells in a 128-bit word for 5x5.
+template <int N>
+struct BoardLayout {
+    static_assert(N >= 2 && N <= 5, "boards from 2x2 to 5x5 are supported");
+
+    using Word = typename std::conditional<N <= 4, uint64_t, unsigned __int128>::type;
+    static constexpr int CELL_BITS = N <= 4 ? 4 : 5;
+};
+
+// Puzzle board packed into fixed-width cells of one machine word.
+// Cell i (row-major) lives in bits [CELL_BITS * i, CELL_BITS * (i + 1));
+// the blank is tile 0.
+template <int N>
+struct PuzzleBoard {
+    using Word = typename BoardLayout<N>::Word;
+
+    static constexpr int WIDTH = N;
+    static constexpr int CELLS = N * N;
+    static constexpr int CELL_BITS = BoardLayout<N>::CELL_BITS;
+    static constexpr Word CELL_MASK = (Word(1) << CELL_BITS) - 1;
+
+    Word tiles;
+    uint8_t blankIndex;  // Cached cell index of the blank
+
+    constexpr PuzzleBoard() : tiles(0), blankIndex(0) {}
+
+    // Pack a row-major array of CELLS tile values
+    static constexpr PuzzleBoard fromCells(const int cells[]) {
+        PuzzleBoard board;
+        for (int i = 0; i < CELLS; ++i) {
+            board.tiles |= Word(cells[i]) << (CELL_BITS * i);
+            if (cells[i] == 0) {
+                board.blankIndex = uint8_t(i);
+            }
+        }
+        return board;
+    }
+
+    constexpr int tileAt(int cell) const {
+        return int((tiles >> (CELL_BITS * cell)) & CELL_MASK);
+    }
+
+    constexpr int blankRow() const { return blankIndex / N; }
+    constexpr int blankCol() const { return blankIndex % N; }
+
+    // Slide the tile at `cell` into the blank. The blank cell is always
+    // zero, so the move is one mask and one shift.
+    constexpr PuzzleBoard moved(int cell) const {
+        Word tile = (tiles >> (CELL_BITS * cell)) & CELL_MASK;
+        PuzzleBoard next;
+        next.tiles = (tiles & ~(CELL_MASK << (CELL_BITS * cell))) | (tile << (CELL_BITS * blankIndex));
+        next.blankIndex = uint8_t(cell);
+        return next;
+    }
+
+    // The packed word determines the blank too, so equality is one compare
+    constexpr bool operator==(const PuzzleBoard& other) const {
+        return tiles == other.tiles;
+    }
+
+    constexpr bool operator!=(const PuzzleBoard& other) const {
+        return tiles != other.tiles;
+    }
+};
+
+// Goal with tiles 1 .. N*N-1 in row-major order and the blank last
+template <int N>
+constexpr PuzzleBoard<N> blankLastGoal() {
+    PuzzleBoard<N> goal;
+    for (int i = 0; i + 1 < N * N; ++i) {
+        goal.tiles |= typename PuzzleBoard<N>::Word(i + 1) << (PuzzleBoard<N>::CELL_BITS * i);
+    }
+    goal.blankIndex = uint8_t(N * N - 1);
+    return goal;
+}
+
+// Goal with tiles 0 .. N*N-1 in row-major order, i.e. the blank first
+template <int N>
+constexpr PuzzleBoard<N> blankFirstGoal() {
+    PuzzleBoard<N> goal;
+    for (int i = 1; i < N * N; ++i) {
+        goal.tiles |= typename PuzzleBoard<N>::Word(i) << (PuzzleBoard<N>::CELL_BITS * i);
+    }
+    return goal;
+}
+
+// Whether `cells` holds each of the tiles 0 .. count-1 exactly once
+inline bool isTilePermutation(const int cells[], int count) {
+    bool seen[32] = {};
+    if (count > 32) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (cells[i] < 0 || cells[i] >= count || seen[cells[i]]) {
+            return false;
+        }
+        seen[cells[i]] = true;
+    }
+    return true;
+}
+
+// Whether `goal` is reachable from `board`. Relabel every tile by its goal
+// cell: each move swaps the blank with a neighbour, which flips both the
+// inversion parity of that sequence and the parity of the blank's distance
+// from its goal cell, so the two parities must agree. Works for any width
+// and any goal layout, and costs O(N^4) integer compares.
+template <int N>
+constexpr bool isSolvable(const PuzzleBoard<N>& board, const PuzzleBoard<N>& goal) {
+    int goalCell[N * N] = {};
+    for (int cell = 0; cell < N * N; ++cell) {
+        goalCell[goal.tileAt(cell)] = cell;
+    }
+    int inversions = 0;
+    for (int i = 0; i < N * N; ++i) {
+        for (int j = i + 1; j < N * N; ++j) {
+            inversions += goalCell[board.tileAt(i)] > goalCell[board.tileAt(j)];
+        }
+    }
+    int rowDistance = board.blankRow() - goal.blankRow();
+    int colDistance = board.blankCol() - goal.blankCol();
+    int blankDistance = (rowDistance < 0 ? -rowDistance : rowDistance) + (colDistance < 0 ? -colDistance : colDistance);
+    return (inversions + blankDistance) % 2 == 0;
+}
+
+// Cells the blank can move to from each cell, built at compile time.
+// Neighbours are listed up, down, left, right.
+template <int N>
+struct MoveTable {
+    uint8_t count[N * N];
+    uint8_t neighbors[N * N][4];
+
+    constexpr MoveTable() : count(), neighbors() {
+        for (int cell = 0; cell < N * N; ++cell) {
+            int row = cell / N, col = cell % N;
+            if (row > 0) neighbors[cell][count[cell]++] = uint8_t(cell - N);
+            if (row < N - 1) neighbors[cell][count[cell]++] = uint8_t(cell + N);
+            if (col > 0) neighbors[cell][count[cell]++] = uint8_t(cell - 1);
+            if (col < N - 1) neighbors[cell][count[cell]++] = uint8_t(cell + 1);
+        }
+    }
+};
+
+template <int N>
+constexpr MoveTable<N> MOVE_TABLE{};
+
+// Successors of one expansion, filled in place by generateSuccessors
+template <int N>
+struct SuccessorBuffer {
+    PuzzleBoard<N> boards[4];
+    uint8_t cells[4];  // Cell of the tile slid into the blank for boards[i]
+    int count;
+};
+
+// Fill `out` with the boards one move from `board`, skipping the move that
+// slides the tile back into `previousBlank` (the parent's blank cell, or -1
+// at the root). The skipped child is always the parent itself.
+template <int N>
+inline int generateSuccessors(const PuzzleBoard<N>& board, int previousBlank, SuccessorBuffer<N>& out) {
+    const int blank = board.blankIndex;
+    out.count = 0;
+    for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+        int cell = MOVE_TABLE<N>.neighbors[blank][i];
+        if (cell != previousBlank) {
+            out.boards[out.count] = board.moved(cell);
+            out.cells[out.count] = uint8_t(cell);
+            ++out.count;
+        }
+    }
+    return out.count;
+}
+
+// 64-bit finalizer (splitmix64) spreading a packed word over all bits
+inline uint64_t mixBoardKey(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+inline uint64_t mixBoardKey(unsigned __int128 key) {
+    return mixBoardKey(uint64_t(key) ^ mixBoardKey(uint64_t(key >> 64)));
+}
+
+// Hash function for PuzzleBoard (used for unordered containers)
+struct PuzzleBoardHash {
+    template <int N>
+    size_t operator()(const PuzzleBoard<N>& board) const {
+        return size_t(mixBoardKey(board.tiles));
+    }
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef PUZZLE_IO_H
+#define PUZZLE_IO_H
+
+#include <ostream>
+
+#include "puzzle_board.h"
+
+// Print one row per line, each tile followed by a space
+template <int N>
+void printBoard(std::ostream& out, const PuzzleBoard<N>& board) {
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            out << board.tileAt(row * N + col) << ' ';
+        }
+        out << '\n';
+    }
+}
+
+#endif
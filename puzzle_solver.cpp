@@ -0,0 +1,394 @@
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "anytime_search.h"
+#include "best_first_search.h"
+#include "bidirectional_search.h"
+#include "greedy_search.h"
+#include "heuristics.h"
+#include "memory_bounded_search.h"
+#include "parallel_search.h"
+#include "pattern_database.h"
+#include "puzzle_board.h"
+#include "puzzle_io.h"
+#include "search_strategy.h"
+#include "solution_table.h"
+#include "solution_writer.h"
+#include "walking_distance.h"
+
+using namespace std;
+
+// Command-line front end to the search library.
+//
+//   puzzle_solver [--strategy astar|parallel|weighted|anytime|sma|greedy|ehc|bidirectional|mm]
+//                 [--threads <count>] [--weight <w>] [--budget-ms <ms>]
+//                 [--memory-mb <mb>] [--heuristic manhattan|misplaced|linear|walking]
+//                 [--goal last|first] [--table <file>] [--pdb <file>]
+//                 [--format tiles|moves|boards] [--trace] [--json] [tile...]
+//
+// The tiles (N*N values, 0 for the blank, N from 2 to 5) are read from the
+// arguments or, when none are given, from one line of stdin. The goal puts
+// the blank last (1 2 ... 0, the default) or first (0 1 2 ...). Parallel is
+// the hash-distributed A* of parallel_search.h on --threads workers (default
+// one per core); it is optimal like astar. Weighted A*
+// uses the --weight (default 2, in steps of 0.1) and finds a solution at most
+// that many times longer than optimal. Anytime is ARA* (anytime_search.h):
+// it starts at the weight, prints each improved solution with its proven
+// bound, and stops at the optimum or after --budget-ms (default 1000).
+// Greedy is the lazy greedy best-first search of greedy_search.h and ehc its
+// enforced hill-climbing; both aim at a fast first solution of any length,
+// ehc's usually shorter.
+// --memory-mb caps the search storage of astar, weighted, anytime, greedy and ehc;
+// sma is the memory-bounded SMA* of memory_bounded_search.h and keeps to
+// the cap (default 256 MB) by forgetting its worst leaves. A search that
+// still runs out fails over to IDA*: optimal IDA* for astar and sma,
+// weighted IDA* at --weight for weighted and anytime (keeping their bound),
+// and weighted IDA* at GREEDY_FALLBACK_WEIGHT for greedy and ehc, which
+// have no bound to keep and should stay fast.
+// Bidirectional is breadth-first from both ends and mm the bidirectional
+// heuristic search of bidirectional_search.h. A solution
+// table from solution_table_builder answers boards of its width and goal by
+// lookup, without searching; other boards fall back to search. --format
+// picks how the solution is written (see solution_writer.h) and --trace
+// writes every board the A*, weighted, greedy and ehc searches expand to stderr.
+// --json
+// replaces the report with one JSON object holding the solution and the
+// search statistics (see search_stats.h).
+// --heuristic linear adds linear conflicts to Manhattan, and walking is the
+// walking distance of walking_distance.h (boards up to 4x4); both are
+// admissible and expand several times fewer nodes than Manhattan.
+// --pdb replaces the heuristic with an additive pattern database from
+// pdb_builder (pattern_database.h), e.g. a 6-6-3 split for 4x4 boards. It
+// must match the board width and is built for the blank-last goal; mm
+// still estimates the backward side with Manhattan distance.
+
+enum class Strategy { ASTAR, PARALLEL, WEIGHTED, ANYTIME, SMA, GREEDY, HILL_CLIMBING, BIDIRECTIONAL_BFS, MEET_IN_THE_MIDDLE };
+const char* const STRATEGY_NAMES[] = {"astar", "parallel", "weighted", "anytime", "sma", "greedy", "ehc", "bidirectional", "mm"};
+
+// Memory cap of SMA* without --memory-mb
+const size_t DEFAULT_SMA_BYTES = size_t(256) << 20;
+
+// Weight of the IDA* fallback of greedy and ehc. Weighted IDA* at 3 solves
+// random 5x5 boards in milliseconds where optimal IDA* runs for hours.
+const double GREEDY_FALLBACK_WEIGHT = 3;
+enum class Heuristic { MANHATTAN, MISPLACED, LINEAR_CONFLICT, WALKING_DISTANCE };
+const char* const HEURISTIC_NAMES[] = {"manhattan", "misplaced", "linear", "walking"};
+
+struct SolverOptions {
+    Strategy strategy = Strategy::ASTAR;
+    Heuristic heuristic = Heuristic::MANHATTAN;
+    bool blankFirst = false;
+    bool json = false;
+    const char* tablePath = nullptr;
+    const char* databasePath = nullptr;
+    SolutionFormat format = SolutionFormat::TILES;
+    bool trace = false;
+    double weight = 2;
+    double budgetSeconds = 1;
+    size_t memoryBytes = 0;  // 0 for no cap
+    int threads = int(thread::hardware_concurrency());
+};
+
+// Observer for runBestFirstSearch printing each expanded board with g and h
+struct ExpansionTrace {
+    BufferedWriter* output;
+
+    template <int N>
+    void expanded(const PuzzleBoard<N>& board, int g, int h) {
+        string& text = output->text();
+        text += "g=";
+        appendNumber(text, g);
+        text += " h=";
+        appendNumber(text, h);
+        text += '\n';
+        appendBoard(text, board);
+        output->done();
+    }
+};
+
+// Tiles moved at each step, as a JSON array
+template <int N>
+void writeMovesJson(ostream& out, const PuzzleBoard<N>& start, const vector<int>& moves) {
+    out << '[';
+    PuzzleBoard<N> board = start;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        out << (i > 0 ? "," : "") << board.tileAt(moves[i]);
+        board = board.moved(moves[i]);
+    }
+    out << ']';
+}
+
+template <int N>
+int report(const PuzzleBoard<N>& start, const SearchResult& result, const SolverOptions& options) {
+    if (options.json) {
+        cout << "{\"solved\":" << (result.solved ? "true" : "false") << ",\"length\":" << result.moves.size()
+             << ",\"bound\":";
+        if (isfinite(result.suboptimalityBound)) {
+            cout << result.suboptimalityBound;
+        } else {
+            cout << "null";
+        }
+        cout << ",\"moves\":";
+        writeMovesJson(cout, start, result.moves);
+        cout << ",\"stats\":";
+        writeStatsJson(cout, result.stats);
+        cout << "}" << endl;
+        return result.solved ? 0 : 1;
+    }
+    if (!result.solved) {
+        cout << "Goal state not reachable." << endl;
+        return 1;
+    }
+
+    cout << "Solved in " << result.moves.size() << " moves:" << (options.format == SolutionFormat::BOARDS ? '\n' : ' ');
+    {
+        BufferedWriter output(stdout);
+        appendSolution(output.text(), start, result.moves, options.format);
+        if (options.format != SolutionFormat::BOARDS) {
+            output.text() += '\n';
+        }
+    }
+    if (result.suboptimalityBound != 1 && isfinite(result.suboptimalityBound)) {
+        cout << "Length bound: " << result.suboptimalityBound << " x optimal" << endl;
+    }
+    if (result.usedFallback) {
+        cout << "Memory cap reached; solved by " << (result.suboptimalityBound == 1 ? "" : "weighted ")
+             << "IDA* fallback" << endl;
+    } else if (result.budgetExhausted) {
+        cout << "Memory cap reached; reporting the best solution found before it" << endl;
+    }
+    cout << "Nodes expanded: " << result.stats.nodesExpanded << ", generated: " << result.stats.nodesGenerated;
+    if (result.stats.seconds > 0) {
+        cout << " (" << uint64_t(result.stats.nodesPerSecond()) << " nodes/sec)";
+    }
+    cout << endl;
+    if (result.stats.peakBytes > 0) {
+        cout << "Peak search memory: " << (result.stats.peakBytes + 1023) / 1024 << " KB" << endl;
+    }
+    return 0;
+}
+
+// `toGoal` estimates the distance to the goal; `toStart` the distance to the
+// start, for the backward side of MM
+template <int N, typename GoalHeuristic, typename StartHeuristic, typename Observer>
+SearchResult runStrategy(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const GoalHeuristic& toGoal,
+                         const StartHeuristic& toStart, const SolverOptions& options, Observer observer) {
+    BidirectionalWorkspace<N> workspace;
+    SearchWorkspace<N>& forward = workspace.forward;
+    forward.setNodeBudget(nodeBudgetForBytes<N>(options.memoryBytes));
+    switch (options.strategy) {
+        case Strategy::PARALLEL: {
+            ThreadPool pool(options.threads);
+            ParallelWorkspace<N> parallelWorkspace;
+            return runParallelAStar(start, goal, toGoal, pool, parallelWorkspace);
+        }
+        case Strategy::WEIGHTED:
+            return runBestFirstSearch(DynamicWeightStrategy(options.weight), start, goal, toGoal, forward, observer);
+        case Strategy::ANYTIME: {
+            AnytimeOptions anytime;
+            anytime.initialWeight = options.weight;
+            anytime.budgetSeconds = options.budgetSeconds;
+            AnytimeWorkspace<N> anytimeWorkspace;
+            anytimeWorkspace.search.setNodeBudget(forward.nodeBudget);
+            return runAnytimeAStar(start, goal, toGoal, anytime, anytimeWorkspace, [&](const SearchResult& solution) {
+                if (!options.json) {
+                    cout << "Found " << solution.moves.size() << " moves, at most " << solution.suboptimalityBound
+                         << " x optimal, after " << solution.stats.seconds * 1000 << " ms" << endl;
+                }
+            });
+        }
+        case Strategy::SMA: {
+            size_t bytes = options.memoryBytes != 0 ? options.memoryBytes : DEFAULT_SMA_BYTES;
+            return runSMAStar(start, goal, toGoal, smaNodeBudgetForBytes<N>(bytes));
+        }
+        case Strategy::GREEDY:
+        case Strategy::HILL_CLIMBING: {
+            GreedyWorkspace<N> greedyWorkspace;
+            greedyWorkspace.search.setNodeBudget(forward.nodeBudget);
+            return options.strategy == Strategy::GREEDY
+                       ? runGreedySearch(start, goal, toGoal, greedyWorkspace, observer)
+                       : runEnforcedHillClimbing(start, goal, toGoal, greedyWorkspace, observer);
+        }
+        case Strategy::BIDIRECTIONAL_BFS: return runBidirectionalBFS(start, goal, workspace);
+        case Strategy::MEET_IN_THE_MIDDLE: return runMeetInTheMiddle(start, goal, toGoal, toStart, workspace);
+        default: return runBestFirstSearch<AStarStrategy>(start, goal, toGoal, forward, observer);
+    }
+}
+
+template <int N, typename GoalHeuristic, typename StartHeuristic>
+SearchResult runStrategy(const PuzzleBoard<N>& start, const PuzzleBoard<N>& goal, const GoalHeuristic& toGoal,
+                         const StartHeuristic& toStart, const SolverOptions& options) {
+    SearchResult result;
+    if (options.trace) {
+        BufferedWriter trace(stderr);
+        result = runStrategy(start, goal, toGoal, toStart, options, ExpansionTrace{&trace});
+    } else {
+        result = runStrategy(start, goal, toGoal, toStart, options, NoTrace());
+    }
+    if (result.budgetExhausted && !result.solved) {
+        switch (options.strategy) {
+            case Strategy::WEIGHTED:
+            case Strategy::ANYTIME:
+                result = failOverToIDAStar(result, DynamicWeightStrategy(options.weight), start, goal, toGoal);
+                break;
+            case Strategy::GREEDY:
+            case Strategy::HILL_CLIMBING:
+                result = failOverToIDAStar(result, DynamicWeightStrategy(GREEDY_FALLBACK_WEIGHT), start, goal, toGoal);
+                break;
+            default: result = failOverToIDAStar(result, start, goal, toGoal);
+        }
+    }
+    return result;
+}
+
+template <int N>
+int solve(const vector<int>& cells, const SolverOptions& options) {
+    PuzzleBoard<N> start = PuzzleBoard<N>::fromCells(cells.data());
+    PuzzleBoard<N> goal = options.blankFirst ? blankFirstGoal<N>() : blankLastGoal<N>();
+    const HeuristicTables<N>& tables = options.blankFirst ? BLANK_FIRST_TABLES<N> : BLANK_LAST_TABLES<N>;
+
+    if (!isSolvable(start, goal)) {
+        cout << (options.json ? "{\"solved\":false,\"unsolvable\":true}" : "Goal state not reachable from this puzzle.") << endl;
+        return 1;
+    }
+    if (!options.json) {
+        cout << "Initial state:" << endl;
+        printBoard(cout, start);
+    }
+
+    if constexpr (solutionTableFits<N>()) {
+        SolutionTable<N> table;
+        if (options.tablePath != nullptr && table.load(options.tablePath) && table.goal == goal) {
+            // A table whose walk breaks off is corrupt; search instead
+            SearchResult result = table.solve(start);
+            if (result.solved) {
+                return report(start, result, options);
+            }
+        }
+    }
+
+    const HeuristicTables<N> startTables(start);
+    SearchResult result;
+    if (options.databasePath != nullptr) {
+        PatternDatabase<N> database;
+        if (options.blankFirst || !database.load(options.databasePath)) {
+            cerr << "could not load a " << N << "x" << N << " blank-last pattern database from " << options.databasePath
+                 << endl;
+            return 2;
+        }
+        result = runStrategy(start, goal, database, ManhattanHeuristic<N>(startTables), options);
+    } else if (options.heuristic == Heuristic::MISPLACED) {
+        result = runStrategy(start, goal, MisplacedTilesHeuristic<N>(tables), MisplacedTilesHeuristic<N>(startTables), options);
+    } else if (options.heuristic == Heuristic::LINEAR_CONFLICT) {
+        result = runStrategy(start, goal, LinearConflictHeuristic<N>(tables), LinearConflictHeuristic<N>(startTables), options);
+    } else if (options.heuristic == Heuristic::WALKING_DISTANCE) {
+        if constexpr (N <= WALKING_DISTANCE_MAX_WIDTH) {
+            result = runStrategy(start, goal, WalkingDistanceHeuristic<N>(tables), WalkingDistanceHeuristic<N>(startTables), options);
+        } else {
+            cerr << "the walking-distance heuristic supports boards up to " << WALKING_DISTANCE_MAX_WIDTH << "x"
+                 << WALKING_DISTANCE_MAX_WIDTH << endl;
+            return 2;
+        }
+    } else {
+        result = runStrategy(start, goal, ManhattanHeuristic<N>(tables), ManhattanHeuristic<N>(startTables), options);
+    }
+    return report(start, result, options);
+}
+
+int usage(const char* program) {
+    cerr << "usage: " << program << " [--strategy astar|parallel|weighted|anytime|sma|greedy|ehc|bidirectional|mm]"
+         << " [--threads <count>] [--weight <w>] [--budget-ms <ms>] [--memory-mb <mb>] [--heuristic manhattan|misplaced|linear|walking] [--goal last|first] [--table <file>] [--pdb <file>]"
+         << " [--format tiles|moves|boards] [--trace] [--json] [tile...]" << endl;
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    SolverOptions options;
+    vector<int> cells;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        string value = i + 1 < argc ? argv[i + 1] : "";
+        if (arg == "--strategy") {
+            int strategy = 0;
+            while (strategy < int(size(STRATEGY_NAMES)) && value != STRATEGY_NAMES[strategy]) {
+                ++strategy;
+            }
+            if (strategy == int(size(STRATEGY_NAMES))) {
+                return usage(argv[0]);
+            }
+            options.strategy = Strategy(strategy);
+            ++i;
+        } else if (arg == "--threads" && atoi(value.c_str()) > 0) {
+            options.threads = atoi(value.c_str());
+            ++i;
+        } else if (arg == "--weight" && atof(value.c_str()) >= 1) {
+            options.weight = atof(value.c_str());
+            ++i;
+        } else if (arg == "--budget-ms" && atof(value.c_str()) > 0) {
+            options.budgetSeconds = atof(value.c_str()) / 1000;
+            ++i;
+        } else if (arg == "--memory-mb" && atof(value.c_str()) > 0) {
+            options.memoryBytes = size_t(atof(value.c_str()) * (1 << 20));
+            ++i;
+        } else if (arg == "--heuristic") {
+            int heuristic = 0;
+            while (heuristic < int(size(HEURISTIC_NAMES)) && value != HEURISTIC_NAMES[heuristic]) {
+                ++heuristic;
+            }
+            if (heuristic == int(size(HEURISTIC_NAMES))) {
+                return usage(argv[0]);
+            }
+            options.heuristic = Heuristic(heuristic);
+            ++i;
+        } else if (arg == "--goal" && (value == "last" || value == "first")) {
+            options.blankFirst = value == "first";
+            ++i;
+        } else if (arg == "--table" && !value.empty()) {
+            options.tablePath = argv[++i];
+        } else if (arg == "--pdb" && !value.empty()) {
+            options.databasePath = argv[++i];
+        } else if (arg == "--format" && (value == "tiles" || value == "moves" || value == "boards")) {
+            options.format = value == "tiles" ? SolutionFormat::TILES
+                             : value == "moves" ? SolutionFormat::MOVES : SolutionFormat::BOARDS;
+            ++i;
+        } else if (arg == "--trace") {
+            options.trace = true;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else if (!arg.empty() && arg.find_first_not_of("0123456789") == string::npos) {
+            // Out-of-range values become -1 and fail the permutation check
+            long tile = strtol(arg.c_str(), nullptr, 10);
+            cells.push_back(tile <= INT_MAX ? int(tile) : -1);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    if (cells.empty()) {
+        int value;
+        while (cin >> value) {
+            cells.push_back(value);
+        }
+    }
+
+    int width = int(lround(sqrt(double(cells.size()))));
+    if (width < 2 || width > 5 || width * width != int(cells.size()) ||
+        !isTilePermutation(cells.data(), int(cells.size()))) {
+        cerr << "expected a permutation of 0..N*N-1 for N from 2 to 5" << endl;
+        return 2;
+    }
+
+    switch (width) {
+        case 2: return solve<2>(cells, options);
+        case 3: return solve<3>(cells, options);
+        case 4: return solve<4>(cells, options);
+        default: return solve<5>(cells, options);
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef SEARCH_RESULT_H
+#define SEARCH_RESULT_H
+
+#include <vector>
+
+#include "search_stats.h"
+
+// Outcome of one solve by any of the search engines
+struct SearchResult {
+    bool solved;
+    std::vector<int> moves;  // Cell of the tile slid into the blank at each step
+    SearchStats stats;
+    double suboptimalityBound;  // Solution cost is at most this times the optimum
+    bool budgetExhausted;       // The search stopped at its node budget, not for lack of a path
+    bool usedFallback;          // Solved by IDA* after the first search ran out of budget
+
+    SearchResult() : solved(false), suboptimalityBound(1), budgetExhausted(false), usedFallback(false) {}
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Build with PUZZLE_SEARCH_STATS=1 (cmake -DPUZZLE_SEARCH_STATS=ON) for the
+// detailed counters and phase timers below. Otherwise they compile away and
+// only the expansion and generation counts are kept.
+#ifndef PUZZLE_SEARCH_STATS
+#define PUZZLE_SEARCH_STATS 0
+#endif
+
+constexpr bool SEARCH_STATS_ENABLED = PUZZLE_SEARCH_STATS != 0;
+
+// Counters and timings of one solve
+struct SearchStats {
+    uint64_t nodesExpanded = 0;
+    uint64_t nodesGenerated = 0;
+    double seconds = 0;
+    uint64_t peakBytes = 0;  // Search storage in use at the end of the solve, which is also its peak
+
+    // Detailed counters, zero unless SEARCH_STATS_ENABLED
+    uint64_t duplicatesRejected = 0;  // Children dropped as already seen
+    uint64_t reopenings = 0;          // Seen boards queued again at a lower g
+    uint64_t peakOpen = 0;
+    uint64_t peakClosed = 0;
+
+    // Phase timings, zero unless SEARCH_STATS_ENABLED. Expansion is whatever
+    // the other phases leave: successor generation and node storage.
+    double heuristicSeconds = 0;
+    double hashSeconds = 0;
+    double queueSeconds = 0;
+
+    double expansionSeconds() const {
+        double rest = seconds - heuristicSeconds - hashSeconds - queueSeconds;
+        return rest > 0 ? rest : 0;
+    }
+
+    double nodesPerSecond() const {
+        return seconds > 0 ? nodesExpanded / seconds : 0;
+    }
+
+    void countDuplicate() {
+        if constexpr (SEARCH_STATS_ENABLED) ++duplicatesRejected;
+    }
+
+    void countReopening() {
+        if constexpr (SEARCH_STATS_ENABLED) ++reopenings;
+    }
+
+    void notePeaks(size_t open, size_t closed) {
+        if constexpr (SEARCH_STATS_ENABLED) {
+            if (open > peakOpen) peakOpen = open;
+            if (closed > peakClosed) peakClosed = closed;
+        }
+    }
+};
+
+// Adds the lifetime of a scope to one phase total; empty when disabled
+template <bool Enabled = SEARCH_STATS_ENABLED>
+struct PhaseTimer {
+    explicit PhaseTimer(double&) {}
+};
+
+template <>
+struct PhaseTimer<true> {
+    double& total;
+    std::chrono::steady_clock::time_point start;
+
+    explicit PhaseTimer(double& phaseTotal) : total(phaseTotal), start(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+        total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// One JSON object; detailed fields only appear when they were collected
+inline void writeStatsJson(std::ostream& out, const SearchStats& stats) {
+    out << "{\"nodes_expanded\":" << stats.nodesExpanded << ",\"nodes_generated\":" << stats.nodesGenerated
+        << ",\"seconds\":" << stats.seconds << ",\"nodes_per_second\":" << stats.nodesPerSecond()
+        << ",\"peak_bytes\":" << stats.peakBytes;
+    if (SEARCH_STATS_ENABLED) {
+        out << ",\"duplicates_rejected\":" << stats.duplicatesRejected << ",\"reopenings\":" << stats.reopenings
+            << ",\"peak_open\":" << stats.peakOpen << ",\"peak_closed\":" << stats.peakClosed
+            << ",\"phase_seconds\":{\"heuristic\":" << stats.heuristicSeconds << ",\"hashing\":" << stats.hashSeconds
+            << ",\"queue\":" << stats.queueSeconds << ",\"expansion\":" << stats.expansionSeconds() << "}";
+    }
+    out << "}";
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef SEARCH_STRATEGY_H
+#define SEARCH_STRATEGY_H
+
+#include <cmath>
+#include <limits>
+
+// Node-ordering policies for runBestFirstSearch. priority() turns g and h
+// into the integer open-list key. REOPENS says whether a cheaper path to a
+// board already seen queues it again, which A* needs for optimal solutions;
+// the other strategies keep the first path found to each board. bound() is
+// the guaranteed ratio of solution cost to optimal cost for a consistent
+// heuristic (Manhattan, misplaced tiles and additive pattern databases are).
+
+// f = g + h: optimal with an admissible heuristic
+struct AStarStrategy {
+    static constexpr bool REOPENS = true;
+
+    static constexpr int priority(int g, int h) { return g + h; }
+    static constexpr double bound() { return 1; }
+};
+
+// f = g + (Numerator / Denominator) * h, scaled by Denominator so keys stay
+// integral. Solutions cost at most Numerator / Denominator times the optimum,
+// even without reopening.
+template <int Numerator, int Denominator = 1>
+struct WeightedAStarStrategy {
+    static_assert(Numerator >= Denominator && Denominator > 0, "weights below 1 are not supported");
+
+    static constexpr bool REOPENS = false;
+
+    static constexpr int priority(int g, int h) { return Denominator * g + Numerator * h; }
+    static constexpr double bound() { return double(Numerator) / Denominator; }
+};
+
+// Weighted A* with the weight chosen at run time, in steps of 1/SCALE
+struct DynamicWeightStrategy {
+    static constexpr int SCALE = 10;
+    static constexpr bool REOPENS = false;
+
+    int scaledWeight;  // Weight times SCALE, at least SCALE
+
+    DynamicWeightStrategy() : scaledWeight(SCALE) {}
+
+    // Rounds `weight` to the nearest step, and up to 1 if below
+    explicit DynamicWeightStrategy(double weight) : scaledWeight(int(std::lround(weight * SCALE))) {
+        if (scaledWeight < SCALE) {
+            scaledWeight = SCALE;
+        }
+    }
+
+    int priority(int g, int h) const { return SCALE * g + scaledWeight * h; }
+    double bound() const { return double(scaledWeight) / SCALE; }
+};
+
+// f = h: fewest expansions, no bound on solution length
+struct GreedyStrategy {
+    static constexpr bool REOPENS = false;
+
+    static constexpr int priority(int, int h) { return h; }
+    static constexpr double bound() { return std::numeric_limits<double>::infinity(); }
+};
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef SIMD_HEURISTICS_H
+#define SIMD_HEURISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PUZZLE_SIMD_X86 1
+#else
+#define PUZZLE_SIMD_X86 0
+#endif
+
+#include "puzzle_board.h"
+
+// Full-board Manhattan and misplaced-tile kernels for boards up to 4x4,
+// whose packed word unpacks to one byte per cell in a 16-byte vector.
+// Manhattan looks up the goal row and column of every cell's tile with a
+// byte shuffle, takes absolute differences against the cell's own row and
+// column and sums them horizontally with SAD; misplaced tiles compares the
+// vector with the goal and counts mask bits. The blank (tile 0) and the
+// unused cells of smaller boards unpack to 0 and are masked out.
+//
+// The kernels are compiled for SSSE3 and AVX2 (two boards per instruction)
+// through function attributes, so the build needs no -m flags; the level is
+// picked at run time from the CPU, or forced with the PUZZLE_SIMD
+// environment variable (scalar, ssse3 or avx2). scalarEvaluate is the
+// portable reference; heuristics.h falls back to its table loop instead,
+// which is faster. The engines score
+// successors incrementally (heuristics.h), which is cheaper than any full
+// evaluation, so in the solvers these kernels only score start boards (and
+// every child in debug builds, to check the incremental values). Batches
+// of boards are scored by puzzle_benchmark alone.
+
+enum class SimdLevel { SCALAR, SSSE3, AVX2 };
+enum class SimdKernel { MANHATTAN, MISPLACED };
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::SSSE3: return "ssse3";
+        default: return "scalar";
+    }
+}
+
+// Best level the CPU supports, capped by PUZZLE_SIMD when set
+inline SimdLevel detectSimdLevel() {
+    SimdLevel level = SimdLevel::SCALAR;
+#if PUZZLE_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        level = SimdLevel::AVX2;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        level = SimdLevel::SSSE3;
+    }
+#endif
+    const char* forced = getenv("PUZZLE_SIMD");
+    if (forced != nullptr) {
+        SimdLevel cap = strcmp(forced, "scalar") == 0  ? SimdLevel::SCALAR
+                        : strcmp(forced, "ssse3") == 0 ? SimdLevel::SSSE3
+                                                       : SimdLevel::AVX2;
+        if (cap < level) {
+            level = cap;
+        }
+    }
+    return level;
+}
+
+// Detected once per process
+inline SimdLevel activeSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+// Goal layout as byte vectors: per tile, the row and column of its goal
+// cell; per cell, its own row and column and its goal tile
+struct SimdGoal {
+    alignas(16) uint8_t tileRow[16];
+    alignas(16) uint8_t tileCol[16];
+    alignas(16) uint8_t cellRow[16];
+    alignas(16) uint8_t cellCol[16];
+    alignas(16) uint8_t goalTile[16];
+};
+
+// Left zeroed for 5x5, which the kernels do not cover
+template <int N>
+constexpr SimdGoal makeSimdGoal(const PuzzleBoard<N>& goal) {
+    SimdGoal simd{};
+    if constexpr (N <= 4) {
+        for (int cell = 0; cell < N * N; ++cell) {
+            int tile = goal.tileAt(cell);
+            simd.tileRow[tile] = uint8_t(cell / N);
+            simd.tileCol[tile] = uint8_t(cell % N);
+            simd.cellRow[cell] = uint8_t(cell / N);
+            simd.cellCol[cell] = uint8_t(cell % N);
+            simd.goalTile[cell] = uint8_t(tile);
+        }
+    }
+    return simd;
+}
+
+template <SimdKernel Kernel>
+inline int scalarEvaluate(uint64_t word, const SimdGoal& goal) {
+    int total = 0;
+    for (int cell = 0; cell < 16; ++cell) {
+        int tile = int(word >> (4 * cell)) & 0xF;
+        if (tile == 0) {
+            continue;
+        }
+        if (Kernel == SimdKernel::MANHATTAN) {
+            int rowDistance = goal.tileRow[tile] - goal.cellRow[cell];
+            int colDistance = goal.tileCol[tile] - goal.cellCol[cell];
+            total += (rowDistance < 0 ? -rowDistance : rowDistance) + (colDistance < 0 ? -colDistance : colDistance);
+        } else {
+            total += tile != goal.goalTile[cell];
+        }
+    }
+    return total;
+}
+
+#if PUZZLE_SIMD_X86
+
+// One byte per cell, cell i in byte i
+__attribute__((target("ssse3"))) inline __m128i unpackCells(uint64_t word) {
+    const __m128i packed = _mm_cvtsi64_si128(int64_t(word));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    return _mm_unpacklo_epi8(_mm_and_si128(packed, nibble), _mm_and_si128(_mm_srli_epi16(packed, 4), nibble));
+}
+
+template <SimdKernel Kernel>
+__attribute__((target("ssse3"))) inline int ssse3Evaluate(uint64_t word, const SimdGoal& goal) {
+    const __m128i cells = unpackCells(word);
+    const __m128i blank = _mm_cmpeq_epi8(cells, _mm_setzero_si128());
+    if (Kernel == SimdKernel::MISPLACED) {
+        __m128i placed = _mm_cmpeq_epi8(cells, _mm_load_si128((const __m128i*)goal.goalTile));
+        return 16 - __builtin_popcount(unsigned(_mm_movemask_epi8(_mm_or_si128(placed, blank))));
+    }
+    __m128i rows = _mm_shuffle_epi8(_mm_load_si128((const __m128i*)goal.tileRow), cells);
+    __m128i cols = _mm_shuffle_epi8(_mm_load_si128((const __m128i*)goal.tileCol), cells);
+    __m128i distance =
+        _mm_add_epi8(_mm_abs_epi8(_mm_sub_epi8(rows, _mm_load_si128((const __m128i*)goal.cellRow))),
+                     _mm_abs_epi8(_mm_sub_epi8(cols, _mm_load_si128((const __m128i*)goal.cellCol))));
+    __m128i sums = _mm_sad_epu8(_mm_andnot_si128(blank, distance), _mm_setzero_si128());
+    return int(_mm_cvtsi128_si64(sums) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+}
+
+// Two boards per 256-bit vector, one in each 128-bit lane
+template <SimdKernel Kernel>
+__attribute__((target("avx2"))) inline void avx2EvaluatePair(uint64_t first, uint64_t second, const SimdGoal& goal,
+                                                              int* out) {
+    const __m256i packed = _mm256_setr_epi64x(int64_t(first), 0, int64_t(second), 0);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i cells = _mm256_unpacklo_epi8(_mm256_and_si256(packed, nibble),
+                                               _mm256_and_si256(_mm256_srli_epi16(packed, 4), nibble));
+    const __m256i blank = _mm256_cmpeq_epi8(cells, _mm256_setzero_si256());
+    if (Kernel == SimdKernel::MISPLACED) {
+        __m256i goalTile = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)goal.goalTile));
+        unsigned mask = unsigned(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(cells, goalTile), blank)));
+        out[0] = 16 - __builtin_popcount(mask & 0xFFFF);
+        out[1] = 16 - __builtin_popcount(mask >> 16);
+        return;
+    }
+    __m256i tileRow = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)goal.tileRow));
+    __m256i tileCol = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)goal.tileCol));
+    __m256i cellRow = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)goal.cellRow));
+    __m256i cellCol = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)goal.cellCol));
+    __m256i distance =
+        _mm256_add_epi8(_mm256_abs_epi8(_mm256_sub_epi8(_mm256_shuffle_epi8(tileRow, cells), cellRow)),
+                        _mm256_abs_epi8(_mm256_sub_epi8(_mm256_shuffle_epi8(tileCol, cells), cellCol)));
+    __m256i sums = _mm256_sad_epu8(_mm256_andnot_si256(blank, distance), _mm256_setzero_si256());
+    out[0] = _mm256_extract_epi32(sums, 0) + _mm256_extract_epi32(sums, 2);
+    out[1] = _mm256_extract_epi32(sums, 4) + _mm256_extract_epi32(sums, 6);
+}
+
+#endif
+
+// Heuristic value of one board at `level`
+template <SimdKernel Kernel, int N>
+inline int evaluateBoard(SimdLevel level, const PuzzleBoard<N>& board, const SimdGoal& goal) {
+    static_assert(N <= 4, "SIMD kernels cover boards up to 4x4");
+#if PUZZLE_SIMD_X86
+    if (level != SimdLevel::SCALAR) {
+        return ssse3Evaluate<Kernel>(board.tiles, goal);
+    }
+#endif
+    (void)level;
+    return scalarEvaluate<Kernel>(board.tiles, goal);
+}
+
+// Heuristic values of `count` boards at `level`, into out[0 .. count)
+template <SimdKernel Kernel, int N>
+inline void evaluateBoards(SimdLevel level, const PuzzleBoard<N>* boards, size_t count, const SimdGoal& goal,
+                           int* out) {
+    static_assert(N <= 4, "SIMD kernels cover boards up to 4x4");
+    size_t i = 0;
+#if PUZZLE_SIMD_X86
+    if (level == SimdLevel::AVX2) {
+        for (; i + 2 <= count; i += 2) {
+            avx2EvaluatePair<Kernel>(boards[i].tiles, boards[i + 1].tiles, goal, out + i);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = evaluateBoard<Kernel>(level, boards[i], goal);
+    }
+}
+
+#endif
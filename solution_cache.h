@@ -0,0 +1,261 @@
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "puzzle_board.h"
+
+struct SolutionCacheCounters {
+    uint64_t hits = 0;       // Lookups answered
+    uint64_t misses = 0;
+    uint64_t stitches = 0;   // Searches that ended through a cached board
+    uint64_t stores = 0;     // Boards added
+    uint64_t evictions = 0;
+
+    void add(const SolutionCacheCounters& other) {
+        hits += other.hits;
+        misses += other.misses;
+        stitches += other.stitches;
+        stores += other.stores;
+        evictions += other.evictions;
+    }
+};
+
+// Bounded, thread-safe LRU cache of optimal solutions for one goal, shared
+// across solves. Storing a solution stores every board along it, since each
+// suffix of an optimal path is optimal for the board it starts from, so
+// later solves can be answered outright or stitched onto (CacheCompletion).
+//
+// Boards are keyed by a canonical encoding. Mirroring a board about the
+// main diagonal and relabeling each tile by where the mirror sends its goal
+// cell maps the goal to itself and keeps every distance, so a board and its
+// mirror share one entry: the one with the smaller packed word. This needs
+// the goal's blank on the diagonal, which holds for the blank-first and
+// blank-last goals; other goals are cached without mirroring.
+//
+// Entries are spread over SHARDS independently locked LRU lists, so
+// concurrent workers rarely wait on each other. Capacity counts boards.
+//
+// Searches probe the cache on expanded boards, mostly for boards it does
+// not hold or whose solution is too long to help. A lock-free table keeps,
+// per hash slot of the raw board, the shortest solution length stored for
+// any board (or mirror) in that slot; a probe that finds the slot empty or
+// no shorter than it needs is turned away before any mirroring, shard
+// hashing or locking. Slots only ever decrease, so evicted boards leave a
+// bound that is still a valid lower bound, costing at most a locked miss.
+template <int N>
+struct SolutionCache {
+    using Word = typename PuzzleBoard<N>::Word;
+
+    static constexpr int SHARDS = 16;
+
+    using Counters = SolutionCacheCounters;
+
+    struct WordHash {
+        size_t operator()(Word key) const { return size_t(mixBoardKey(key)); }
+    };
+
+    struct Entry {
+        Word key;
+        std::vector<uint8_t> moves;  // Optimal solution of the canonical board
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> entries;  // Most recently used first
+        std::unordered_map<Word, typename std::list<Entry>::iterator, WordHash> index;
+        Counters counters;
+    };
+
+    // Length-bound slots per board of capacity, and the most there may be
+    static constexpr size_t BOUND_SLOTS_PER_BOARD = 8;
+    static constexpr size_t MAX_BOUND_SLOTS = size_t(1) << 28;
+    static constexpr uint8_t EMPTY_SLOT = UINT8_MAX;
+
+    PuzzleBoard<N> goal;
+    bool mirrors;
+    uint8_t relabel[N * N];  // Tile of the mirrored board for each tile
+    size_t shardCapacity;
+    Shard shards[SHARDS];
+    std::unique_ptr<std::atomic<uint8_t>[]> shortest;  // Length bound per slot, EMPTY_SLOT if none
+    uint64_t slotMask;  // Slot count - 1; the count is a power of two
+    std::atomic<uint64_t> stitchCount{0};
+
+    SolutionCache(const PuzzleBoard<N>& cacheGoal, size_t capacity)
+        : goal(cacheGoal), mirrors(cacheGoal.blankRow() == cacheGoal.blankCol()), relabel(),
+          shardCapacity(capacity / SHARDS + 1) {
+        size_t slots = 64;
+        while (slots < MAX_BOUND_SLOTS && slots < capacity * BOUND_SLOTS_PER_BOARD) {
+            slots *= 2;
+        }
+        shortest.reset(new std::atomic<uint8_t>[slots]);
+        for (size_t i = 0; i < slots; ++i) {
+            shortest[i].store(EMPTY_SLOT, std::memory_order_relaxed);
+        }
+        slotMask = slots - 1;
+        int goalCell[N * N] = {};
+        for (int cell = 0; cell < N * N; ++cell) {
+            goalCell[goal.tileAt(cell)] = cell;
+        }
+        for (int tile = 0; tile < N * N; ++tile) {
+            relabel[tile] = uint8_t(goal.tileAt(transposed(goalCell[tile])));
+        }
+    }
+
+    SolutionCache(const SolutionCache&) = delete;
+    SolutionCache& operator=(const SolutionCache&) = delete;
+
+    static int transposed(int cell) { return cell % N * N + cell / N; }
+
+    PuzzleBoard<N> mirrored(const PuzzleBoard<N>& board) const {
+        int cells[N * N];
+        for (int cell = 0; cell < N * N; ++cell) {
+            cells[transposed(cell)] = relabel[board.tileAt(cell)];
+        }
+        return PuzzleBoard<N>::fromCells(cells);
+    }
+
+    // Optimal moves from `board` to the goal into `moves`; false on a miss
+    bool lookup(const PuzzleBoard<N>& board, std::vector<int>& moves) { return fetch(board, moves, SIZE_MAX, true); }
+
+    // As lookup, for a board reached inside a search: only solutions shorter
+    // than `maxLength` are copied out, and nothing is counted, so probes do
+    // not swamp the hit rate. The search calls countStitch() when it ends
+    // through the returned tail.
+    bool stitch(const PuzzleBoard<N>& board, int maxLength, std::vector<int>& moves) {
+        int bound = shortestBound(board.tiles);
+        if (bound == EMPTY_SLOT || bound >= maxLength) {
+            return false;
+        }
+        return fetch(board, moves, size_t(maxLength), false);
+    }
+
+    void countStitch() { stitchCount.fetch_add(1, std::memory_order_relaxed); }
+
+    // Record the optimal solution `moves` of `start` and of every board on it
+    void store(const PuzzleBoard<N>& start, const std::vector<int>& moves) {
+        PuzzleBoard<N> board = start;
+        for (size_t step = 0; step <= moves.size(); ++step) {
+            storeBoard(board, moves, step);
+            if (step < moves.size()) {
+                board = board.moved(moves[step]);
+            }
+        }
+    }
+
+    Counters counters() {
+        Counters total;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.add(shard.counters);
+        }
+        total.stitches += stitchCount.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    // Copies the solution out only when it is shorter than `maxLength`;
+    // `counting` records the hit or miss
+    bool fetch(const PuzzleBoard<N>& board, std::vector<int>& moves, size_t maxLength, bool counting) {
+        bool mirror = false;
+        Word key = canonicalKey(board, mirror);
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+            shard.counters.misses += counting;
+            return false;
+        }
+        const std::vector<uint8_t>& stored = found->second->moves;
+        if (stored.size() >= maxLength) {
+            return false;
+        }
+        shard.counters.hits += counting;
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        moves.resize(stored.size());
+        for (size_t i = 0; i < stored.size(); ++i) {
+            moves[i] = mirror ? transposed(stored[i]) : stored[i];
+        }
+        return true;
+    }
+
+    Word canonicalKey(const PuzzleBoard<N>& board, bool& mirror) const {
+        mirror = false;
+        if (!mirrors) {
+            return board.tiles;
+        }
+        Word other = mirrored(board).tiles;
+        mirror = other < board.tiles;
+        return mirror ? other : board.tiles;
+    }
+
+    Shard& shardOf(Word key) { return shards[(mixBoardKey(key) >> 32) % SHARDS]; }
+
+    // No board in the slot of `tiles` has a stored solution shorter than this
+    int shortestBound(Word tiles) const {
+        return shortest[mixBoardKey(tiles) & slotMask].load(std::memory_order_relaxed);
+    }
+
+    void lowerBound(Word tiles, size_t length) {
+        std::atomic<uint8_t>& slot = shortest[mixBoardKey(tiles) & slotMask];
+        uint8_t bound = uint8_t(std::min<size_t>(length, EMPTY_SLOT - 1));
+        uint8_t current = slot.load(std::memory_order_relaxed);
+        while (bound < current && !slot.compare_exchange_weak(current, bound, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Store the tail of `moves` from `step` on, the solution of `board`
+    void storeBoard(const PuzzleBoard<N>& board, const std::vector<int>& moves, size_t step) {
+        bool mirror = false;
+        Word key = canonicalKey(board, mirror);
+        // Bounded before the entry exists, so a probe turned away by the
+        // bound would have missed the entry too
+        lowerBound(board.tiles, moves.size() - step);
+        if (mirrors) {
+            lowerBound(mirrored(board).tiles, moves.size() - step);
+        }
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            return;
+        }
+        std::vector<uint8_t> tail;
+        tail.reserve(moves.size() - step);
+        for (size_t i = step; i < moves.size(); ++i) {
+            tail.push_back(uint8_t(mirror ? transposed(moves[i]) : moves[i]));
+        }
+        shard.entries.push_front(Entry{key, std::move(tail)});
+        shard.index[key] = shard.entries.begin();
+        ++shard.counters.stores;
+        if (shard.entries.size() > shardCapacity) {
+            shard.index.erase(shard.entries.back().key);
+            shard.entries.pop_back();
+            ++shard.counters.evictions;
+        }
+    }
+};
+
+// Completion for runBestFirstSearch that stitches the search onto any
+// expanded board the cache already holds
+template <int N>
+struct CacheCompletion {
+    SolutionCache<N>* cache;
+
+    bool complete(const PuzzleBoard<N>& board, int maxLength, std::vector<int>& tail) {
+        return cache->stitch(board, maxLength, tail);
+    }
+
+    void stitched() { cache->countStitch(); }
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef SOLUTION_TABLE_H
+#define SOLUTION_TABLE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include "mapped_file.h"
+#include "permutation_rank.h"
+#include "puzzle_board.h"
+#include "search_result.h"
+
+// On-disk layout of a complete solution table (all fields little-endian):
+//   SolutionTableHeader
+//   one byte per solvable board, indexed by solutionTableIndex()
+// Each byte holds the optimal distance to the goal in bits 0-4 and, in bits
+// 5-6, which MOVE_TABLE neighbour of the blank to move towards the goal;
+// 0xFF marks a board the generator never reached. A 3x3 table is 9!/2 =
+// 181,440 bytes; no 3x3 board is more than 31 moves from its goal, which
+// is also the largest distance the five bits hold.
+const int SOLUTION_TABLE_MAX_DEPTH = 31;
+const char SOLUTION_TABLE_MAGIC[4] = {'S', 'O', 'L', '1'};
+const uint8_t SOLUTION_UNREACHED = 0xFF;
+
+struct SolutionTableHeader {
+    char magic[4];
+    uint8_t width;
+    uint8_t reserved[3];
+    uint8_t goal[16];  // Goal tile at each cell
+    uint64_t entryCount;
+};
+
+// Tables cover every solvable board, so they only exist up to 3x3
+template <int N>
+constexpr bool solutionTableFits() {
+    return N <= 3;
+}
+
+// Perfect hash of a board into 0 .. (N*N)!/2 - 1: the rank of the cells of
+// tiles 0 .. N*N-3. The two remaining tiles fill the two free cells in one
+// of two orders, which differ by a swap of two tiles and so in solvability.
+template <int N>
+uint64_t solutionTableIndex(const PuzzleBoard<N>& board) {
+    uint8_t tileCells[N * N];
+    for (int cell = 0; cell < N * N; ++cell) {
+        tileCells[board.tileAt(cell)] = uint8_t(cell);
+    }
+    return rankPattern(tileCells, N * N - 2, N * N);
+}
+
+template <int N>
+uint64_t solutionTableEntryCount() {
+    return patternEntryCount(N * N, N * N - 2);
+}
+
+// Read-only view of a solution table file mapped into memory. solve() walks
+// the stored best moves, so a solution costs one lookup per move and no
+// search at all.
+template <int N>
+struct SolutionTable {
+    static_assert(solutionTableFits<N>(), "solution tables are limited to 3x3 boards");
+
+    MappedFile file;
+    const uint8_t* entries;
+    PuzzleBoard<N> goal;
+
+    SolutionTable() : entries(nullptr) {}
+
+    bool loaded() const { return entries != nullptr; }
+
+    // Map `path`; returns false if the file is missing, malformed, not
+    // exactly the expected size or built for another board width
+    bool load(const char* path) {
+        unload();
+        if (!file.open(path, sizeof(SolutionTableHeader))) {
+            return false;
+        }
+        SolutionTableHeader header;
+        memcpy(&header, file.data, sizeof(header));
+        int cells[N * N];
+        for (int i = 0; i < N * N; ++i) {
+            cells[i] = header.goal[i];
+        }
+        bool padded = header.reserved[0] == 0 && header.reserved[1] == 0 && header.reserved[2] == 0;
+        for (int i = N * N; i < int(sizeof(header.goal)); ++i) {
+            padded = padded && header.goal[i] == 0;
+        }
+        if (memcmp(header.magic, SOLUTION_TABLE_MAGIC, sizeof(SOLUTION_TABLE_MAGIC)) != 0 || header.width != N ||
+            !padded || header.entryCount != solutionTableEntryCount<N>() ||
+            file.size != sizeof(SolutionTableHeader) + header.entryCount || !isTilePermutation(cells, N * N)) {
+            unload();
+            return false;
+        }
+        goal = PuzzleBoard<N>::fromCells(cells);
+        entries = file.data + sizeof(SolutionTableHeader);
+        if (entries[solutionTableIndex(goal)] != 0) {
+            unload();
+            return false;
+        }
+        return true;
+    }
+
+    void unload() {
+        file.close();
+        entries = nullptr;
+    }
+
+    // Optimal number of moves to the goal, -1 for boards that cannot reach it
+    int distance(const PuzzleBoard<N>& board) const {
+        if (!isSolvable(board, goal)) {
+            return -1;
+        }
+        uint8_t entry = entries[solutionTableIndex(board)];
+        return entry == SOLUTION_UNREACHED ? -1 : entry & 0x1F;
+    }
+
+    // Optimal solution towards `goal` in O(depth) lookups. Each stored move
+    // must lead to a board one move closer, so a corrupt table ends the walk
+    // within SOLUTION_TABLE_MAX_DEPTH steps and leaves the result unsolved.
+    SearchResult solve(const PuzzleBoard<N>& start) const {
+        auto startTime = std::chrono::steady_clock::now();
+        SearchResult result;
+        int depth = distance(start);
+        if (depth >= 0 && depth <= SOLUTION_TABLE_MAX_DEPTH) {
+            PuzzleBoard<N> board = start;
+            uint8_t entry = entries[solutionTableIndex(board)];
+            while (depth > 0) {
+                int slot = entry >> 5;
+                if (slot >= MOVE_TABLE<N>.count[board.blankIndex]) {
+                    break;
+                }
+                int cell = MOVE_TABLE<N>.neighbors[board.blankIndex][slot];
+                result.moves.push_back(cell);
+                board = board.moved(cell);
+                ++result.stats.nodesExpanded;
+                entry = entries[solutionTableIndex(board)];
+                if (entry == SOLUTION_UNREACHED || (entry & 0x1F) != depth - 1) {
+                    break;
+                }
+                --depth;
+            }
+            result.solved = depth == 0 && board == goal;
+            if (!result.solved) {
+                result.moves.clear();
+            }
+        }
+        result.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return result;
+    }
+};
+
+#endif
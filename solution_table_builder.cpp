@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "puzzle_board.h"
+#include "solution_table.h"
+
+using namespace std;
+
+// Offline builder for complete solution tables (see solution_table.h).
+//
+//   solution_table_builder <width> <output-file> [last|first]
+//
+// e.g. solution_table_builder 3 eight-puzzle.sol
+//
+// A breadth-first search backwards from the goal (blank last by default)
+// reaches every solvable board. When a board is first reached from its
+// parent, the move back to that parent is its best move.
+
+template <int N>
+vector<uint8_t> buildTable(const PuzzleBoard<N>& goal) {
+    vector<uint8_t> entries(solutionTableEntryCount<N>(), SOLUTION_UNREACHED);
+    vector<PuzzleBoard<N>> queue;
+    queue.reserve(entries.size());
+
+    entries[solutionTableIndex(goal)] = 0;
+    queue.push_back(goal);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        PuzzleBoard<N> board = queue[head];
+        int distance = entries[solutionTableIndex(board)] & 0x1F;
+        int blank = board.blankIndex;
+
+        for (int i = 0; i < MOVE_TABLE<N>.count[blank]; ++i) {
+            PuzzleBoard<N> child = board.moved(MOVE_TABLE<N>.neighbors[blank][i]);
+            uint8_t& entry = entries[solutionTableIndex(child)];
+            if (entry != SOLUTION_UNREACHED) {
+                continue;
+            }
+            // The child returns to `board` by sliding the tile at board's blank
+            int back = 0;
+            while (MOVE_TABLE<N>.neighbors[child.blankIndex][back] != blank) {
+                ++back;
+            }
+            entry = uint8_t((distance + 1) | (back << 5));
+            queue.push_back(child);
+        }
+    }
+    cout << "Reached " << queue.size() << " of " << entries.size() << " boards" << endl;
+    return entries;
+}
+
+template <int N>
+bool writeTable(const char* path, bool blankFirst) {
+    PuzzleBoard<N> goal = blankFirst ? blankFirstGoal<N>() : blankLastGoal<N>();
+    vector<uint8_t> entries = buildTable<N>(goal);
+
+    SolutionTableHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SOLUTION_TABLE_MAGIC, sizeof(SOLUTION_TABLE_MAGIC));
+    header.width = uint8_t(N);
+    for (int cell = 0; cell < N * N; ++cell) {
+        header.goal[cell] = uint8_t(goal.tileAt(cell));
+    }
+    header.entryCount = entries.size();
+
+    FILE* out = fopen(path, "wb");
+    if (out == NULL) {
+        return false;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(entries.data(), 1, entries.size(), out);
+    bool ok = ferror(out) == 0;
+    ok = fclose(out) == 0 && ok;
+    cout << "Wrote " << path << " (" << sizeof(header) + entries.size() << " bytes)" << endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4 || (argc == 4 && strcmp(argv[3], "last") != 0 && strcmp(argv[3], "first") != 0)) {
+        cerr << "usage: " << argv[0] << " <width> <output-file> [last|first]" << endl;
+        return 1;
+    }
+    bool blankFirst = argc == 4 && strcmp(argv[3], "first") == 0;
+
+    bool ok = false;
+    switch (atoi(argv[1])) {
+        case 2: ok = writeTable<2>(argv[2], blankFirst); break;
+        case 3: ok = writeTable<3>(argv[2], blankFirst); break;
+        default:
+            cerr << "solution tables are built for widths 2 and 3" << endl;
+            return 1;
+    }
+    if (!ok) {
+        cerr << "could not write " << argv[2] << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#ifndef SOLUTION_WRITER_H
+#define SOLUTION_WRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "puzzle_board.h"
+
+// Text encodings of a solution:
+//   MOVES   direction the blank moves at each step, e.g. "LURD"
+//   TILES   tile slid at each step, space separated
+//   BOARDS  every board from the start to the goal, one row per line and a
+//           blank line after each board
+enum class SolutionFormat { MOVES, TILES, BOARDS };
+
+// Letter for the blank moving from `blank` to the adjacent `cell`
+template <int N>
+char moveLetter(int blank, int cell) {
+    if (cell == blank - N) return 'U';
+    if (cell == blank + N) return 'D';
+    return cell < blank ? 'L' : 'R';
+}
+
+inline void appendNumber(std::string& out, int value) {
+    char digits[12];
+    int length = 0;
+    do {
+        digits[length++] = char('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (length > 0) {
+        out += digits[--length];
+    }
+}
+
+template <int N>
+void appendBoard(std::string& out, const PuzzleBoard<N>& board) {
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            appendNumber(out, board.tileAt(row * N + col));
+            out += ' ';
+        }
+        out += '\n';
+    }
+}
+
+// Append `moves` from `start` in `format`. MOVES and TILES add no newline.
+template <int N>
+void appendSolution(std::string& out, const PuzzleBoard<N>& start, const std::vector<int>& moves,
+                    SolutionFormat format) {
+    PuzzleBoard<N> board = start;
+    if (format == SolutionFormat::BOARDS) {
+        appendBoard(out, board);
+        out += '\n';
+    }
+    for (size_t i = 0; i < moves.size(); ++i) {
+        int cell = moves[i];
+        if (format == SolutionFormat::MOVES) {
+            out += moveLetter<N>(board.blankIndex, cell);
+        } else if (format == SolutionFormat::TILES) {
+            if (i > 0) {
+                out += ' ';
+            }
+            appendNumber(out, board.tileAt(cell));
+        }
+        board = board.moved(cell);
+        if (format == SolutionFormat::BOARDS) {
+            appendBoard(out, board);
+            out += '\n';
+        }
+    }
+}
+
+// Output staged in one buffer and handed to stdio in large writes, so
+// nothing is flushed per line. Flushes on destruction.
+struct BufferedWriter {
+    FILE* out;
+    std::string buffer;
+
+    static const size_t FLUSH_BYTES = 1 << 16;
+
+    explicit BufferedWriter(FILE* stream) : out(stream) {
+        buffer.reserve(FLUSH_BYTES * 2);
+    }
+
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Staging string for appendSolution and friends; call done() after
+    std::string& text() { return buffer; }
+
+    void done() {
+        if (buffer.size() >= FLUSH_BYTES) {
+            flush();
+        }
+    }
+
+    void write(const std::string& text) {
+        buffer += text;
+        done();
+    }
+
+    void flush() {
+        if (!buffer.empty()) {
+            fwrite(buffer.data(), 1, buffer.size(), out);
+            buffer.clear();
+        }
+        fflush(out);
+    }
+};
+
+#endif
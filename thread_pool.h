@@ -0,0 +1,93 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run indexed jobs in parallel. Workers
+// stay alive between run() calls and each keeps its worker id, so callers
+// can give every worker its own scratch state.
+struct ThreadPool {
+    explicit ThreadPool(int threadCount) : job(nullptr), jobCount(0), nextIndex(0), active(0), generation(0), stopping(false) {
+        if (threadCount < 1) {
+            threadCount = 1;
+        }
+        for (int id = 0; id < threadCount; ++id) {
+            workers.emplace_back([this, id] { workerLoop(id); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        startSignal.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return int(workers.size()); }
+
+    // Call work(workerId, index) for every index in [0, count) and wait for
+    // all of them; indices are handed out dynamically to balance the load
+    void run(size_t count, const std::function<void(int, size_t)>& work) {
+        std::unique_lock<std::mutex> lock(mutex);
+        job = &work;
+        jobCount = count;
+        nextIndex = 0;
+        active = int(workers.size());
+        ++generation;
+        startSignal.notify_all();
+        doneSignal.wait(lock, [this] { return active == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable startSignal;
+    std::condition_variable doneSignal;
+    const std::function<void(int, size_t)>* job;
+    size_t jobCount;
+    std::atomic<size_t> nextIndex;
+    int active;
+    uint64_t generation;
+    bool stopping;
+
+    void workerLoop(int id) {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            startSignal.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+            const std::function<void(int, size_t)>* work = job;
+            size_t count = jobCount;
+            lock.unlock();
+
+            for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+                (*work)(id, i);
+            }
+
+            lock.lock();
+            if (--active == 0) {
+                doneSignal.notify_one();
+            }
+        }
+    }
+};
+
+#endif